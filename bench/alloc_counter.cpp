@@ -0,0 +1,23 @@
+#include "alloc_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace /* local to this file only */ {
+std::atomic<std::size_t> allocations{0};
+} // namespace
+
+std::size_t allocation_count() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,12 @@
+#ifndef INCLUDED_MU_BENCH_ALLOC_COUNTER_HPP
+#define INCLUDED_MU_BENCH_ALLOC_COUNTER_HPP
+#include <atomic>
+#include <cstddef>
+
+/// Counts calls to the global `operator new`. The counting replacement of
+/// `operator new` is defined in exactly one translation unit of the benchmark
+/// executable (see alloc_counter.cpp).
+///
+std::size_t allocation_count();
+
+#endif
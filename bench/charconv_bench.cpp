@@ -0,0 +1,42 @@
+#include "alloc_counter.hpp"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <mu/mu.hpp>
+#include <string_view>
+
+namespace /* local to this file only */ {
+
+using speed = mu::quantity<double, mu::mult<mu::kilometer, mu::per<mu::hour>>>;
+
+void BM_ToChars(benchmark::State &state) {
+  std::array<char, 64> buf;
+  mu::format_options opts;
+  opts.labels = mu::format_options::label_type::symbols;
+  speed q{88.5};
+  std::size_t before = allocation_count();
+  for (auto _ : state) {
+    auto result = mu::to_chars(buf.data(), buf.data() + buf.size(), q, opts);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocation_count() - before),
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ToChars);
+
+void BM_FromChars(benchmark::State &state) {
+  std::string_view text = "88.5 km * hr^-1";
+  speed q{};
+  std::size_t before = allocation_count();
+  for (auto _ : state) {
+    auto result = mu::from_chars(text.data(), text.data() + text.size(), q);
+    benchmark::DoNotOptimize(result);
+    benchmark::DoNotOptimize(q);
+  }
+  state.counters["allocs_per_call"] = benchmark::Counter(
+      static_cast<double>(allocation_count() - before),
+      benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FromChars);
+
+} // namespace
@@ -0,0 +1,40 @@
+// Compile-time benchmark for dimensional analysis of large unit expressions.
+//
+// This file is compiled once for each factor count in MU_BENCH_FACTOR_COUNT.
+// It analyzes conversions between two scaled products of that many distinct
+// units, where every unit is scaled by a different rational value.
+
+#include <mu/mu.hpp>
+#include <utility>
+
+#ifndef MU_BENCH_FACTOR_COUNT
+#define MU_BENCH_FACTOR_COUNT 8
+#endif
+
+namespace /* local to this file only */ {
+
+template <std::size_t Index> struct distinct_unit {
+  constexpr static const char *name = "distinct_unit";
+  constexpr static const char *symbol = "u";
+};
+
+template <std::size_t Index>
+using scaled_unit = mu::mult<std::ratio<Index % 97 + 2, Index % 89 + 3>,
+                             distinct_unit<Index>>;
+
+template <std::size_t... Indices>
+auto make_product(std::index_sequence<Indices...>)
+    -> mu::mult<scaled_unit<Indices>...>;
+
+template <std::size_t... Indices>
+auto make_reverse_product(std::index_sequence<Indices...>)
+    -> mu::mult<scaled_unit<sizeof...(Indices) - 1 - Indices>...>;
+
+using indices = std::make_index_sequence<MU_BENCH_FACTOR_COUNT>;
+using product = decltype(make_product(indices{}));
+using reverse_product = decltype(make_reverse_product(indices{}));
+
+static_assert(mu::units_equivalent_to<product, reverse_product>);
+static_assert(mu::units_convertible_to<product, mu::mult<reverse_product>>);
+
+} // namespace
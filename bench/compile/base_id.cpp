@@ -0,0 +1,32 @@
+// Compile-time benchmark for base-id assignment in concrete_factor_generator.
+//
+// This file is compiled once for each factor count in MU_BENCH_FACTOR_COUNT.
+// It generates the concrete factors of a product of that many distinct units,
+// followed by each of the units again, so every base appears twice.
+
+#include <mu/mu.hpp>
+#include <utility>
+
+#ifndef MU_BENCH_FACTOR_COUNT
+#define MU_BENCH_FACTOR_COUNT 16
+#endif
+
+namespace /* local to this file only */ {
+
+template <std::size_t Index> struct distinct_unit {
+  constexpr static const char *name = "distinct_unit";
+  constexpr static const char *symbol = "u";
+};
+
+template <std::size_t... Indices>
+auto make_factors(std::index_sequence<Indices...>)
+    -> mu::mult<distinct_unit<Indices>..., distinct_unit<Indices>...>;
+
+using factors = decltype(make_factors(
+    std::make_index_sequence<MU_BENCH_FACTOR_COUNT>{}));
+using generator = mu::detail::concrete_factor_generator<factors>;
+
+constexpr auto concrete_factors = generator::make_concrete_factors();
+static_assert(concrete_factors[MU_BENCH_FACTOR_COUNT].base_id == 0);
+
+} // namespace
@@ -0,0 +1,212 @@
+# Compile-time benchmark driver, run by the `mu_compile_bench` target.
+#
+# Generates one synthetic translation unit for each combination of parameters,
+# compiles it, and writes a JSON report of the results.
+#
+# Parameters, each a comma-separated list of values:
+#   UNITS        Number of distinct named units.
+#   DEPTH        Nesting depth of each unit expression.
+#   CONVERSIONS  Number of quantity conversions.
+#   PREFIXES     Whether expressions use SI prefixes (ON or OFF).
+#
+# Other inputs:
+#   CXX          The C++ compiler.
+#   CXX_ID       CMAKE_CXX_COMPILER_ID of the compiler.
+#   CXX_FLAGS    Extra compiler flags, separated by spaces.
+#   INCLUDE_DIR  The mu include directory.
+#   OUTPUT_DIR   Receives the generated sources, objects and the report.
+#   TIME         Optional GNU time executable, used to measure the wall time
+#                and the peak RSS.
+#
+# For each translation unit, the report holds the wall time of the compiler,
+# its peak RSS (if TIME is set), and the compiler's own breakdown: the
+# `-ftime-report` phases of GCC, or the instantiation counts and times from
+# the `-ftime-trace` of Clang. Values a compiler does not report are `null`.
+#
+# The wall time is measured by TIME to the hundredth of a second. Without TIME,
+# it is measured by CMake to the microsecond, or only to the second before CMake
+# 3.23.
+
+cmake_minimum_required(VERSION 3.22)
+
+foreach(param UNITS DEPTH CONVERSIONS PREFIXES)
+  string(REPLACE "," ";" ${param} "${${param}}")
+endforeach()
+separate_arguments(CXX_FLAGS UNIX_COMMAND "${CXX_FLAGS}")
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+
+# Writes a translation unit with `units` named units. Each unit expression
+# multiplies and divides by other units `depth` times, so it keeps the
+# dimension of its unit, and each conversion converts one of them back to its
+# unit (scaled by a prefix, if `prefixes` is set).
+function(generate_source path units depth conversions prefixes)
+  set(src "// Generated by compile_bench.cmake. Do not edit.\n")
+  string(APPEND src "#include <mu/mu.hpp>\n\nnamespace bench {\n\n")
+  math(EXPR last_unit "${units} - 1")
+  foreach(i RANGE ${last_unit})
+    string(APPEND src "struct unit_${i} {\n"
+           "  constexpr static const char *name = \"unit_${i}\";\n"
+           "  constexpr static const char *symbol = \"u${i}\";\n};\n")
+  endforeach()
+  string(APPEND src "\n")
+  foreach(i RANGE ${last_unit})
+    if(prefixes)
+      string(APPEND src
+             "using expr_${i}_0 = mu::mult<mu::kilo, unit_${i}>;\n")
+    else()
+      string(APPEND src "using expr_${i}_0 = unit_${i};\n")
+    endif()
+    if(depth GREATER 0)
+      foreach(d RANGE 1 ${depth})
+        math(EXPR prev "${d} - 1")
+        math(EXPR other "(${i} + ${d}) % ${units}")
+        string(APPEND src "using expr_${i}_${d} = "
+               "mu::mult<expr_${i}_${prev}, unit_${other}, "
+               "mu::per<unit_${other}>>;\n")
+      endforeach()
+    endif()
+  endforeach()
+  string(APPEND src "\n")
+  if(conversions GREATER 0)
+    math(EXPR last_conversion "${conversions} - 1")
+    foreach(c RANGE ${last_conversion})
+      math(EXPR i "${c} % ${units}")
+      if(prefixes)
+        set(to "mu::mult<mu::milli, unit_${i}>")
+      else()
+        set(to "unit_${i}")
+      endif()
+      string(APPEND src "double convert_${c}(double value) {\n"
+             "  mu::quantity<double, expr_${i}_${depth}> from{value};\n"
+             "  mu::quantity<double, ${to}> to{from};\n"
+             "  return to.value();\n}\n")
+    endforeach()
+  endif()
+  string(APPEND src "\n} // namespace bench\n")
+  file(WRITE "${path}" "${src}")
+endfunction()
+
+# Returns the current time in microseconds.
+function(now_us out)
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    # %f is the zero-padded microsecond part of %s.
+    string(TIMESTAMP result "%s%f")
+  else()
+    string(TIMESTAMP result "%s000000")
+  endif()
+  set(${out} ${result} PARENT_SCOPE)
+endfunction()
+
+# Extracts the wall time of a `-ftime-report` phase, or `null`.
+function(gcc_phase_seconds out report phase)
+  # The wall time is the last time column, followed by the memory column.
+  set(time "([0-9.]+) \\([ 0-9]+%\\)")
+  set(memory "[0-9.]+[kMG]? \\([ 0-9]+%\\)")
+  set(result null)
+  if(report MATCHES "${phase}[ ]*:[^\n]* ${time}[ ]+${memory}")
+    set(result ${CMAKE_MATCH_1})
+  endif()
+  set(${out} ${result} PARENT_SCOPE)
+endfunction()
+
+set(results "")
+foreach(units IN LISTS UNITS)
+  foreach(depth IN LISTS DEPTH)
+    foreach(conversions IN LISTS CONVERSIONS)
+      foreach(prefixes IN LISTS PREFIXES)
+        if(prefixes)
+          set(prefixes_json true)
+        else()
+          set(prefixes_json false)
+        endif()
+        set(name "tu_u${units}_d${depth}_c${conversions}_p${prefixes_json}")
+        set(source "${OUTPUT_DIR}/${name}.cpp")
+        set(object "${OUTPUT_DIR}/${name}.o")
+        generate_source("${source}" ${units} ${depth} ${conversions}
+                        ${prefixes})
+
+        set(command "${CXX}" -std=c++20 ${CXX_FLAGS} "-I${INCLUDE_DIR}" -c
+                    "${source}" -o "${object}")
+        if(CXX_ID MATCHES "Clang")
+          list(APPEND command -ftime-trace -ftime-trace-granularity=0)
+        elseif(CXX_ID STREQUAL "GNU")
+          list(APPEND command -ftime-report)
+        endif()
+        set(time_file "${OUTPUT_DIR}/${name}.time")
+        if(TIME)
+          set(command "${TIME}" -f "%e %M" -o "${time_file}" ${command})
+        endif()
+
+        message(STATUS "mu_compile_bench: ${name}")
+        now_us(start)
+        execute_process(COMMAND ${command} RESULT_VARIABLE status
+                        OUTPUT_VARIABLE output ERROR_VARIABLE output)
+        now_us(stop)
+        if(NOT status EQUAL 0)
+          message(FATAL_ERROR "Failed to compile ${source}:\n${output}")
+        endif()
+        math(EXPR wall_ms "(${stop} - ${start}) / 1000")
+
+        set(peak_rss_kb null)
+        if(TIME AND EXISTS "${time_file}")
+          # The elapsed seconds, with two decimals, and the peak RSS in KiB.
+          file(STRINGS "${time_file}" measured
+               REGEX "^[0-9]+\\.[0-9][0-9] [0-9]+$")
+          if(measured MATCHES "^([0-9]+)\\.([0-9][0-9]) ([0-9]+)$")
+            math(EXPR wall_ms
+                 "${CMAKE_MATCH_1} * 1000 + ${CMAKE_MATCH_2} * 10")
+            set(peak_rss_kb ${CMAKE_MATCH_3})
+          endif()
+        endif()
+
+        set(instantiations null)
+        set(instantiation_seconds null)
+        set(constexpr_seconds null)
+        if(CXX_ID MATCHES "Clang")
+          # The trace ends with one "Total" event per kind of event, holding
+          # the total duration in microseconds and the number of events.
+          file(READ "${OUTPUT_DIR}/${name}.json" trace)
+          set(instantiations 0)
+          set(instantiation_us 0)
+          foreach(kind Class Function)
+            set(total "\"name\":\"Total Instantiate${kind}\"")
+            if(trace MATCHES
+               "\"dur\":([0-9]+),${total},\"args\":{\"count\":([0-9]+)")
+              math(EXPR instantiation_us
+                   "${instantiation_us} + ${CMAKE_MATCH_1}")
+              math(EXPR instantiations
+                   "${instantiations} + ${CMAKE_MATCH_2}")
+            endif()
+          endforeach()
+          math(EXPR instantiation_ms "${instantiation_us} / 1000")
+          set(instantiation_seconds "${instantiation_ms}e-3")
+        elseif(CXX_ID STREQUAL "GNU")
+          gcc_phase_seconds(instantiation_seconds "${output}"
+                            "template instantiation")
+          gcc_phase_seconds(constexpr_seconds "${output}"
+                            "constant expression evaluation")
+        endif()
+
+        string(
+          CONCAT result
+                 "    {\"name\": \"${name}\", \"units\": ${units}, "
+                 "\"depth\": ${depth}, \"conversions\": ${conversions}, "
+                 "\"prefixes\": ${prefixes_json}, \"wall_ms\": ${wall_ms}, "
+                 "\"peak_rss_kb\": ${peak_rss_kb}, "
+                 "\"instantiations\": ${instantiations}, "
+                 "\"instantiation_seconds\": ${instantiation_seconds}, "
+                 "\"constexpr_seconds\": ${constexpr_seconds}}")
+        if(results)
+          string(APPEND results ",\n")
+        endif()
+        string(APPEND results "${result}")
+      endforeach()
+    endforeach()
+  endforeach()
+endforeach()
+
+set(report "${OUTPUT_DIR}/mu_compile_bench.json")
+file(WRITE "${report}"
+     "{\n  \"compiler\": \"${CXX_ID}\",\n"
+     "  \"results\": [\n${results}\n  ]\n}\n")
+message(STATUS "mu_compile_bench: wrote ${report}")
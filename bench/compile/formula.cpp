@@ -0,0 +1,54 @@
+// Compile-time benchmark for quantity arithmetic.
+//
+// This file is compiled twice: once as written, and once with
+// MU_CANONICAL_ARITHMETIC defined. Compare the compile times reported by the
+// build, and the symbol sizes of the two object files.
+
+#include <mu/quantity.hpp>
+#include <mu/units/si_units.hpp>
+
+namespace /* local to this file only */ {
+
+using length = mu::quantity<double, mu::meter>;
+using duration = mu::quantity<double, mu::second>;
+using mass = mu::quantity<double, mu::kilogram>;
+using current = mu::quantity<double, mu::ampere>;
+
+/// Multiplies `Count` factors, cycling through four different units. Each
+/// product is a distinct instantiation of `operator*`.
+template <int Count>
+auto accumulate(length l, duration t, mass m, current i) {
+  if constexpr (Count == 0) {
+    return l / l;
+  } else if constexpr (Count % 4 == 0) {
+    return accumulate<Count - 1>(l, t, m, i) * l;
+  } else if constexpr (Count % 4 == 1) {
+    return accumulate<Count - 1>(l, t, m, i) / t;
+  } else if constexpr (Count % 4 == 2) {
+    return accumulate<Count - 1>(l, t, m, i) * m;
+  } else {
+    return accumulate<Count - 1>(l, t, m, i) / i;
+  }
+}
+
+} // namespace
+
+/// A 24-term formula, written out by hand.
+double formula(length l, duration t, mass m, current i) {
+  auto q = l * t / m * i * l / t * m / i * l * l / t / t * m * i / l * t /
+           m / i * l * t * m * i / l / t;
+  mu::quantity<double, mu::mult<mu::pow<mu::meter, 3>, mu::per<mu::second>,
+                                mu::kilogram, mu::ampere>>
+      result{q};
+  return result.value();
+}
+
+/// A 32-term product, unrolled by templates.
+double unrolled(length l, duration t, mass m, current i) {
+  auto q = accumulate<32>(l, t, m, i);
+  mu::quantity<double,
+               mu::mult<mu::pow<mu::meter, 8>, mu::per<mu::second, 8>,
+                        mu::pow<mu::kilogram, 8>, mu::per<mu::ampere, 8>>>
+      result{q};
+  return result.value();
+}
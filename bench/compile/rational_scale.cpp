@@ -0,0 +1,45 @@
+// Compile-time benchmark for unit expressions with many rational scales.
+//
+// Checks the convertibility of every pair of speeds built from SI prefixes,
+// minutes and hours, so the same rational values appear in many expressions.
+
+#include <mu/mu.hpp>
+#include <tuple>
+#include <utility>
+
+namespace /* local to this file only */ {
+
+using lengths =
+    std::tuple<mu::meter, mu::nanometer, mu::micrometer, mu::millimeter,
+               mu::centimeter, mu::kilometer, mu::mult<mu::mega, mu::meter>,
+               mu::mult<mu::giga, mu::meter>>;
+
+using durations = std::tuple<mu::second, mu::millisecond, mu::microsecond,
+                             mu::nanosecond, mu::minute, mu::hour,
+                             mu::mult<mu::kilo, mu::second>>;
+
+constexpr std::size_t length_count = std::tuple_size_v<lengths>;
+constexpr std::size_t speed_count =
+    length_count * std::tuple_size_v<durations>;
+
+template <std::size_t Index>
+using speed =
+    mu::mult<std::tuple_element_t<Index % length_count, lengths>,
+             mu::per<std::tuple_element_t<Index / length_count, durations>>>;
+
+/// Counts the speeds in `To...` that `speed<From>` is convertible to.
+template <std::size_t From, std::size_t... To>
+constexpr std::size_t count_row(std::index_sequence<To...>) {
+  return (std::size_t{mu::units_convertible_to<speed<From>, speed<To>>} + ...);
+}
+
+template <std::size_t... From>
+constexpr std::size_t count_convertible(std::index_sequence<From...> indices) {
+  return (count_row<From>(indices) + ...);
+}
+
+// Some pairs are not convertible, because their integer conversion factor
+// overflows, so only check that the count was computed.
+static_assert(count_convertible(std::make_index_sequence<speed_count>{}) > 0);
+
+} // namespace
@@ -0,0 +1,36 @@
+// Compile-time benchmark for pairwise convertibility checks.
+//
+// This file is compiled once for each unit count in MU_BENCH_UNIT_COUNT. It
+// defines that many distinct, mutually convertible unit expressions, and
+// checks the convertibility of every ordered pair.
+
+#include <mu/mu.hpp>
+#include <utility>
+
+#ifndef MU_BENCH_UNIT_COUNT
+#define MU_BENCH_UNIT_COUNT 8
+#endif
+
+namespace /* local to this file only */ {
+
+template <std::size_t Index>
+using scaled_speed = mu::mult<mu::npow<10, static_cast<int>(Index % 7)>,
+                              mu::npow<2, static_cast<int>(Index / 7)>,
+                              mu::kilometer, mu::newton, mu::per<mu::hour>,
+                              mu::per<mu::joule>>;
+
+template <std::size_t From, std::size_t... To>
+constexpr bool row_convertible(std::index_sequence<To...>) {
+  return (mu::units_convertible_to<scaled_speed<From>, scaled_speed<To>> &&
+          ...);
+}
+
+template <std::size_t... From>
+constexpr bool all_convertible(std::index_sequence<From...> indices) {
+  return (row_convertible<From>(indices) && ...);
+}
+
+static_assert(
+    all_convertible(std::make_index_sequence<MU_BENCH_UNIT_COUNT>{}));
+
+} // namespace
@@ -0,0 +1,71 @@
+#include "conversion_loops.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace /* local to this file only */ {
+
+constexpr std::size_t element_count = 4096;
+
+template <class From, class To, auto Loop>
+void run_loop(benchmark::State &state) {
+  std::vector<From> in(element_count, From{12});
+  std::vector<To> out(element_count);
+  for (auto _ : state) {
+    Loop(in.data(), out.data(), in.size());
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(element_count));
+}
+
+void BM_ConvertFloatMillimetersToMeters(benchmark::State &state) {
+  run_loop<float_millimeters, float_meters,
+           static_cast<void (*)(const float_millimeters *, float_meters *,
+                                std::size_t)>(convert_loop)>(state);
+}
+BENCHMARK(BM_ConvertFloatMillimetersToMeters);
+
+void BM_ConvertFloatMillimetersToMetersBuffer(benchmark::State &state) {
+  run_loop<float_millimeters, float_meters, convert_buffer>(state);
+}
+BENCHMARK(BM_ConvertFloatMillimetersToMetersBuffer);
+
+void BM_ConvertIntMillisecondsToDoubleSeconds(benchmark::State &state) {
+  run_loop<int_milliseconds, double_seconds,
+           static_cast<void (*)(const int_milliseconds *, double_seconds *,
+                                std::size_t)>(convert_loop)>(state);
+}
+BENCHMARK(BM_ConvertIntMillisecondsToDoubleSeconds);
+
+void BM_ConvertDoubleSecondsToIntMinutes(benchmark::State &state) {
+  run_loop<double_seconds, int_minutes,
+           static_cast<void (*)(const double_seconds *, int_minutes *,
+                                std::size_t)>(convert_loop)>(state);
+}
+BENCHMARK(BM_ConvertDoubleSecondsToIntMinutes);
+
+void BM_ConvertIntMillisecondsToIntSeconds(benchmark::State &state) {
+  run_loop<int_milliseconds, int_seconds,
+           static_cast<void (*)(const int_milliseconds *, int_seconds *,
+                                std::size_t)>(convert_loop)>(state);
+}
+BENCHMARK(BM_ConvertIntMillisecondsToIntSeconds);
+
+void BM_ConvertIntKilometersToMillimetersSaturating(benchmark::State &state) {
+  run_loop<int_kilometers, int_millimeters, convert_loop_saturating>(state);
+}
+BENCHMARK(BM_ConvertIntKilometersToMillimetersSaturating);
+
+void BM_ConvertIntKilometersToMillimetersByHand(benchmark::State &state) {
+  run_loop<int_kilometers, int_millimeters, convert_loop_saturating_by_hand>(
+      state);
+}
+BENCHMARK(BM_ConvertIntKilometersToMillimetersByHand);
+
+void BM_ConvertDoubleSecondsToIntMinutesLongDouble(benchmark::State &state) {
+  run_loop<double_seconds, int_minutes, convert_loop_long_double>(state);
+}
+BENCHMARK(BM_ConvertDoubleSecondsToIntMinutesLongDouble);
+
+} // namespace
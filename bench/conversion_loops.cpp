@@ -0,0 +1,63 @@
+#include "conversion_loops.hpp"
+#include <limits>
+#include <span>
+
+void convert_loop(const float_millimeters *in, float_meters *out,
+                  std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = mu::quantity_cast<float, mu::meter>(in[i]);
+  }
+}
+
+void convert_loop(const int_milliseconds *in, double_seconds *out,
+                  std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = mu::quantity_cast<double, mu::second>(in[i]);
+  }
+}
+
+void convert_loop(const double_seconds *in, int_minutes *out,
+                  std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = mu::quantity_cast<std::int32_t, mu::minute>(in[i]);
+  }
+}
+
+void convert_loop(const int_milliseconds *in, int_seconds *out,
+                  std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = mu::quantity_cast<std::int32_t, mu::second>(in[i]);
+  }
+}
+
+void convert_buffer(const float_millimeters *in, float_meters *out,
+                    std::size_t count) {
+  mu::convert(std::span{in, count}, std::span{out, count});
+}
+
+void convert_loop_saturating(const int_kilometers *in, int_millimeters *out,
+                             std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = mu::saturating_quantity_cast<std::int32_t, mu::millimeter>(in[i]);
+  }
+}
+
+void convert_loop_saturating_by_hand(const int_kilometers *in,
+                                     int_millimeters *out, std::size_t count) {
+  constexpr std::int32_t max = std::numeric_limits<std::int32_t>::max();
+  constexpr std::int32_t min = std::numeric_limits<std::int32_t>::min();
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::int64_t value = std::int64_t{in[i].value()} * 1'000'000;
+    out[i] = int_millimeters{
+        value > max ? max
+                    : (value < min ? min : static_cast<std::int32_t>(value))};
+  }
+}
+
+void convert_loop_long_double(const double_seconds *in, int_minutes *out,
+                              std::size_t count) {
+  constexpr long double scale = mu::units_conversion_v<mu::second, mu::minute>;
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = int_minutes{static_cast<std::int32_t>(in[i].value() * scale)};
+  }
+}
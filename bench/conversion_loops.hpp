@@ -0,0 +1,51 @@
+#ifndef INCLUDED_MU_BENCH_CONVERSION_LOOPS_HPP
+#define INCLUDED_MU_BENCH_CONVERSION_LOOPS_HPP
+#include <cstddef>
+#include <cstdint>
+#include <mu/mu.hpp>
+
+/// Loops that convert arrays of quantities to other units. They are defined in
+/// conversion_loops.cpp, which is compiled with the compiler's vectorization
+/// remarks enabled, so the build log shows which loops were vectorized.
+
+using float_millimeters = mu::quantity<float, mu::millimeter>;
+using float_meters = mu::quantity<float, mu::meter>;
+using int_milliseconds = mu::quantity<std::int32_t, mu::millisecond>;
+using double_seconds = mu::quantity<double, mu::second>;
+using double_minutes = mu::quantity<double, mu::minute>;
+using int_minutes = mu::quantity<std::int32_t, mu::minute>;
+using int_seconds = mu::quantity<std::int32_t, mu::second>;
+using int_kilometers = mu::quantity<std::int32_t, mu::kilometer>;
+using int_millimeters = mu::quantity<std::int32_t, mu::millimeter>;
+
+void convert_loop(const float_millimeters *in, float_meters *out,
+                  std::size_t count);
+
+void convert_loop(const int_milliseconds *in, double_seconds *out,
+                  std::size_t count);
+
+void convert_loop(const double_seconds *in, int_minutes *out,
+                  std::size_t count);
+
+void convert_loop(const int_milliseconds *in, int_seconds *out,
+                  std::size_t count);
+
+/// Like the overload converting to `float_meters`, but through `mu::convert`.
+void convert_buffer(const float_millimeters *in, float_meters *out,
+                    std::size_t count);
+
+/// Converts kilometers to millimeters, saturating values that overflow.
+void convert_loop_saturating(const int_kilometers *in, int_millimeters *out,
+                             std::size_t count);
+
+/// Like `convert_loop_saturating`, but with the range checks written by hand.
+void convert_loop_saturating_by_hand(const int_kilometers *in,
+                                     int_millimeters *out, std::size_t count);
+
+/// Like the overload converting to `int_minutes`, but scales by a
+/// `long double`, as every conversion to an integer rep did before scales were
+/// relaxed.
+void convert_loop_long_double(const double_seconds *in, int_minutes *out,
+                              std::size_t count);
+
+#endif
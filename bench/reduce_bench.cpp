@@ -0,0 +1,45 @@
+#include "reduce_loops.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace /* local to this file only */ {
+
+constexpr std::size_t element_count = 4096;
+
+template <auto Reduce> void run_reduce(benchmark::State &state) {
+  std::vector<double_meters> in(element_count, double_meters{1.5});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Reduce(in.data(), in.size()));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(element_count));
+}
+
+void BM_SumPairwise(benchmark::State &state) {
+  run_reduce<sum_pairwise>(state);
+}
+BENCHMARK(BM_SumPairwise);
+
+void BM_SumCompensated(benchmark::State &state) {
+  run_reduce<sum_compensated>(state);
+}
+BENCHMARK(BM_SumCompensated);
+
+void BM_SumByHand(benchmark::State &state) { run_reduce<sum_by_hand>(state); }
+BENCHMARK(BM_SumByHand);
+
+void BM_Max(benchmark::State &state) { run_reduce<max_value>(state); }
+BENCHMARK(BM_Max);
+
+void BM_Dot(benchmark::State &state) {
+  std::vector<double_newtons> lhs(element_count, double_newtons{2.0});
+  std::vector<double_meters> rhs(element_count, double_meters{1.5});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dot_product(lhs.data(), rhs.data(), lhs.size()));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(element_count));
+}
+BENCHMARK(BM_Dot);
+
+} // namespace
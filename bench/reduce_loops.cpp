@@ -0,0 +1,28 @@
+#include "reduce_loops.hpp"
+#include <span>
+
+double_meters sum_pairwise(const double_meters *in, std::size_t count) {
+  return mu::reduce::sum(std::span{in, count});
+}
+
+double_meters sum_compensated(const double_meters *in, std::size_t count) {
+  return mu::reduce::sum<mu::summation::compensated>(std::span{in, count});
+}
+
+double_meters sum_by_hand(const double_meters *in, std::size_t count) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < count; ++i) {
+    sum += in[i].value();
+  }
+  return double_meters{sum};
+}
+
+double_meters max_value(const double_meters *in, std::size_t count) {
+  return mu::reduce::max(std::span{in, count});
+}
+
+mu::quantity<double, mu::joule> dot_product(const double_newtons *lhs,
+                                            const double_meters *rhs,
+                                            std::size_t count) {
+  return mu::reduce::dot(std::span{lhs, count}, std::span{rhs, count});
+}
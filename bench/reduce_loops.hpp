@@ -0,0 +1,30 @@
+#ifndef INCLUDED_MU_BENCH_REDUCE_LOOPS_HPP
+#define INCLUDED_MU_BENCH_REDUCE_LOOPS_HPP
+#include <cstddef>
+#include <mu/mu.hpp>
+
+/// Reductions over arrays of quantities. They are defined in reduce_loops.cpp,
+/// which is compiled with the compiler's vectorization remarks enabled, so the
+/// build log shows which loops were vectorized.
+
+using double_meters = mu::quantity<double, mu::meter>;
+using double_newtons = mu::quantity<double, mu::newton>;
+
+/// Adds the values with `mu::reduce::sum`, by pairwise summation.
+double_meters sum_pairwise(const double_meters *in, std::size_t count);
+
+/// Adds the values with `mu::reduce::sum`, by compensated summation.
+double_meters sum_compensated(const double_meters *in, std::size_t count);
+
+/// Adds the values one after another, as a plain loop does.
+double_meters sum_by_hand(const double_meters *in, std::size_t count);
+
+/// Finds the greatest value with `mu::reduce::max`.
+double_meters max_value(const double_meters *in, std::size_t count);
+
+/// Computes the dot product with `mu::reduce::dot`.
+mu::quantity<double, mu::joule> dot_product(const double_newtons *lhs,
+                                            const double_meters *rhs,
+                                            std::size_t count);
+
+#endif
@@ -0,0 +1,108 @@
+#include "alloc_counter.hpp"
+#include <benchmark/benchmark.h>
+#include <mu/mu.hpp>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace /* local to this file only */ {
+
+/// Stream buffer that discards its output, so the only allocations observed
+/// are the ones made while formatting.
+class null_streambuf : public std::streambuf {
+protected:
+  int_type overflow(int_type ch) override { return ch; }
+  std::streamsize xsputn(const char *, std::streamsize count) override {
+    return count;
+  }
+};
+
+using speed = mu::quantity<double, mu::mult<mu::kilometer, mu::per<mu::hour>>>;
+
+/// How `operator<<` formatted labels before they were precomputed: build a
+/// `unit_string` and a `std::string` on every insertion.
+template <mu::rep Rep, mu::units Units>
+void insert_legacy(std::ostream &stream, const mu::quantity<Rep, Units> &q,
+                   const mu::format_options &opts) {
+  stream << q.value() << ' ' << mu::to_string<Units>(opts);
+}
+
+void report_allocations(benchmark::State &state, std::size_t before) {
+  state.counters["allocs_per_insertion"] = benchmark::Counter(
+      static_cast<double>(allocation_count() - before),
+      benchmark::Counter::kAvgIterations);
+}
+
+void BM_InsertLegacy(benchmark::State &state) {
+  null_streambuf buf;
+  std::ostream stream{&buf};
+  mu::format_options opts;
+  opts.labels = mu::format_options::label_type::symbols;
+  speed q{88.5};
+  std::size_t before = allocation_count();
+  for (auto _ : state) {
+    insert_legacy(stream, q, opts);
+  }
+  report_allocations(state, before);
+}
+BENCHMARK(BM_InsertLegacy);
+
+void BM_Insert(benchmark::State &state) {
+  null_streambuf buf;
+  std::ostream stream{&buf};
+  stream << mu::stream::symbols;
+  speed q{88.5};
+  std::size_t before = allocation_count();
+  for (auto _ : state) {
+    stream << q;
+  }
+  report_allocations(state, before);
+}
+BENCHMARK(BM_Insert);
+
+void BM_InsertCustomSep(benchmark::State &state) {
+  null_streambuf buf;
+  std::ostream stream{&buf};
+  stream << mu::stream::symbols << mu::stream::mult_sep(" • ");
+  speed q{88.5};
+  std::size_t before = allocation_count();
+  for (auto _ : state) {
+    stream << q;
+  }
+  report_allocations(state, before);
+}
+BENCHMARK(BM_InsertCustomSep);
+
+std::vector<speed> make_speeds(std::size_t count) {
+  std::vector<speed> speeds;
+  for (std::size_t i = 0; i < count; ++i) {
+    speeds.emplace_back(0.37 * static_cast<double>(i));
+  }
+  return speeds;
+}
+
+void BM_InsertEach(benchmark::State &state) {
+  null_streambuf buf;
+  std::ostream stream{&buf};
+  auto speeds = make_speeds(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (const auto &q : speeds) {
+      stream << q << ", ";
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_InsertEach)->Arg(1024);
+
+void BM_WriteRange(benchmark::State &state) {
+  null_streambuf buf;
+  std::ostream stream{&buf};
+  auto speeds = make_speeds(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    mu::stream::write_range(stream, speeds);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteRange)->Arg(1024);
+
+} // namespace
@@ -0,0 +1,159 @@
+#ifndef INCLUDED_MU_CHARCONV_HPP
+#define INCLUDED_MU_CHARCONV_HPP
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <mu/detail/unit_label.hpp>
+#include <mu/format_options.hpp>
+#include <mu/quantity.hpp>
+#include <mu/units.hpp>
+#include <string_view>
+#include <system_error>
+
+namespace mu {
+
+namespace detail {
+
+/// Concept matches representations that `std::to_chars` can write.
+///
+template <class Rep>
+concept to_chars_rep = requires(char *ptr, const Rep &value) {
+  { std::to_chars(ptr, ptr, value) } -> std::same_as<std::to_chars_result>;
+};
+
+/// Concept matches representations that `std::from_chars` can parse.
+///
+template <class Rep>
+concept from_chars_rep = requires(const char *ptr, Rep &value) {
+  { std::from_chars(ptr, ptr, value) } -> std::same_as<std::from_chars_result>;
+};
+
+/// Matches every precomputed label of `Units` against the beginning of
+/// \p input, and returns the length of the longest match, or 0 if none match.
+///
+template <units Units>
+constexpr std::size_t match_any_unit_label(std::string_view mult_sep,
+                                           std::string_view input) {
+  std::size_t longest = 0;
+  for (const auto &label : unit_label_table<Units>::labels) {
+    longest = std::max(longest, match_unit_label(label, mult_sep, input));
+  }
+  return longest;
+}
+
+} // namespace detail
+
+/// Writes a quantity to a character buffer, as `<value> <units>`. The value is
+/// written by `std::to_chars`, and the units are written from the precomputed
+/// label of `Units`. This function never allocates and never throws.
+///
+/// \param first Beginning of the destination buffer.
+/// \param last End of the destination buffer.
+/// \param q The quantity to write.
+/// \param opts Options that select how the units are written.
+/// \return On success, `ptr` is one-past the last character written and `ec`
+/// is value-initialized. If the buffer is too small, `ptr` is \p last, `ec` is
+/// `std::errc::value_too_large`, and the contents of the buffer are
+/// unspecified.
+///
+template <rep Rep, units Units>
+requires detail::to_chars_rep<Rep>
+std::to_chars_result to_chars(char *first, char *last,
+                              const quantity<Rep, Units> &q,
+                              const format_options &opts = {}) {
+  auto result = std::to_chars(first, last, q.value());
+  if (result.ec != std::errc{}) {
+    return result;
+  }
+  const auto &label = detail::unit_label_table<Units>::get(opts);
+  std::size_t label_size = 0;
+  detail::write_unit_label(
+      label, opts.mult_sep,
+      [&](const char *, std::size_t size) { label_size += size; });
+  char *out = result.ptr;
+  if (static_cast<std::size_t>(last - out) < label_size + 1) {
+    return {last, std::errc::value_too_large};
+  }
+  *out++ = ' ';
+  detail::write_unit_label(label, opts.mult_sep,
+                           [&](const char *data, std::size_t size) {
+                             out = std::copy_n(data, size, out);
+                           });
+  return {out, std::errc{}};
+}
+
+/// Parses a quantity from a character buffer, as written by `mu::to_chars`.
+///
+/// The value is parsed by `std::from_chars`. It must be followed by a single
+/// space and then a label of `Units`, or a label of one of the `Alternatives`.
+/// Names and symbols are both recognized, as are ASCII and superscript
+/// exponents; only the mult separator must be given in \p opts. If the text
+/// matches more than one label, the longest match wins. A value parsed in
+/// alternative units is converted to `Units`, allowing loss of precision.
+/// This function never allocates and never throws.
+///
+/// \tparam Rep Representation of the parsed quantity.
+/// \tparam Units Units of the parsed quantity.
+/// \tparam Alternatives Other units that are recognized and converted to
+/// `Units`.
+/// \param first Beginning of the source buffer.
+/// \param last End of the source buffer.
+/// \param q Receives the parsed quantity. Unmodified on error.
+/// \param opts Provides the expected mult separator.
+/// \return On success, `ptr` is one-past the last character parsed and `ec` is
+/// value-initialized. If the value cannot be parsed, the result of
+/// `std::from_chars` is returned. If the units are missing or unrecognized,
+/// `ptr` is \p first and `ec` is `std::errc::invalid_argument`.
+///
+template <rep Rep, units Units, units... Alternatives>
+requires detail::from_chars_rep<Rep> &&
+         (quantity_lossily_convertible_to<Rep, Alternatives, Rep, Units> && ...)
+std::from_chars_result from_chars(const char *first, const char *last,
+                                  quantity<Rep, Units> &q,
+                                  const format_options &opts = {}) {
+  Rep value{};
+  auto result = std::from_chars(first, last, value);
+  if (result.ec != std::errc{}) {
+    return result;
+  }
+  std::string_view input{result.ptr,
+                         static_cast<std::size_t>(last - result.ptr)};
+  if (input.empty() || input.front() != ' ') {
+    return {first, std::errc::invalid_argument};
+  }
+  input.remove_prefix(1);
+
+  // Find the units with the longest matching label, then convert from them.
+  std::size_t longest = 0;
+  std::size_t longest_index = 0;
+  std::size_t index = 0;
+  auto match = [&]<class FromUnits>() {
+    auto matched =
+        detail::match_any_unit_label<FromUnits>(opts.mult_sep, input);
+    if (matched > longest) {
+      longest = matched;
+      longest_index = index;
+    }
+    ++index;
+  };
+  match.template operator()<Units>();
+  (match.template operator()<Alternatives>(), ...);
+  if (longest == 0) {
+    return {first, std::errc::invalid_argument};
+  }
+
+  index = 0;
+  auto convert = [&]<class FromUnits>() {
+    if (index++ == longest_index) {
+      q = quantity<Rep, Units>{
+          detail::convert_lossily<Rep, Units, FromUnits>(std::move(value))};
+    }
+  };
+  convert.template operator()<Units>();
+  (convert.template operator()<Alternatives>(), ...);
+  return {input.data() + longest, std::errc{}};
+}
+
+} // namespace mu
+
+#endif
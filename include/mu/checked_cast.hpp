@@ -0,0 +1,371 @@
+#ifndef INCLUDED_MU_CHECKED_CAST_HPP
+#define INCLUDED_MU_CHECKED_CAST_HPP
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <mu/quantity.hpp>
+#include <mu/rep.hpp>
+#include <mu/rounding.hpp>
+#include <mu/units.hpp>
+#include <mu/units_conversion.hpp>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mu {
+
+namespace detail {
+
+/// Range checks for converting a value of the fundamental type `FromRep` in
+/// `FromUnits` to the fundamental integral type `ToRep` in `ToUnits`.
+///
+/// If `FromRep` is integral and the conversion is an integer, or a ratio of
+/// integers, the value is scaled exactly in integer arithmetic (see
+/// `scale_int`). The result is monotonic in the value, so the values that
+/// convert without overflow form an interval. Its bounds are found at compile
+/// time, and each value is then checked by two comparisons at most. If the
+/// interval covers every `FromRep`, no check is made at all.
+///
+/// Otherwise, the value is scaled by a floating-point value (see
+/// `relaxed_scale_t`), and the scaled value is compared to the range of `ToRep`
+/// before it is rounded.
+///
+/// \tparam FromRep Converting from this representation.
+/// \tparam FromUnits Converting from these units.
+/// \tparam ToRep Converting to this representation.
+/// \tparam ToUnits Converting to these units.
+/// \tparam Rounding How to round the converted value.
+///
+template <base_rep FromRep, units FromUnits, std::integral ToRep,
+          units ToUnits, rounding Rounding>
+requires units_convertible_to<FromUnits, ToUnits>
+struct checked_conversion {
+private:
+  using conversion = units_conversion<FromUnits, ToUnits>;
+  constexpr static auto &ao = analysis_object<FromUnits, ToUnits>;
+
+  using from_limits = std::numeric_limits<FromRep>;
+  using to_limits = std::numeric_limits<ToRep>;
+
+  /// Integer arithmetic is done in the same type as `scale_int`.
+  using work_type = std::conditional_t<std::is_signed_v<FromRep>,
+                                       std::intmax_t, std::uintmax_t>;
+
+  constexpr static std::intmax_t num =
+      ao.is_int_convertible ? ao.int_conversion : conversion::ratio_num;
+  constexpr static std::intmax_t den =
+      ao.is_int_convertible ? 1 : conversion::ratio_den;
+
+public:
+  /// True if the value is scaled exactly in integer arithmetic.
+  constexpr static bool is_exact =
+      std::integral<FromRep> &&
+      (ao.is_int_convertible || conversion::is_int_ratio) &&
+      (std::is_signed_v<FromRep> || num > 0);
+
+  /// True if larger values convert to larger results. Values below the range
+  /// of `ToRep` saturate to its minimum if this is true, else to its maximum.
+  constexpr static bool is_increasing = ao.is_int_convertible
+                                            ? ao.int_conversion > 0
+                                            : ao.float_conversion > 0;
+
+private:
+  /// Scales \p value exactly, or returns `std::nullopt` if the result does not
+  /// fit in a `ToRep`. The value is split as in `scale_int`, and only the
+  /// product of the quotient and `num` can overflow a `work_type`.
+  constexpr static std::optional<work_type> scale_exact(work_type value) {
+    const work_type quotient = value / static_cast<work_type>(den);
+    const work_type remainder = value % static_cast<work_type>(den);
+    work_type product = 0;
+    if (quotient != 0) {
+      if constexpr (std::is_signed_v<work_type>) {
+        const auto checked = safe_mult(quotient, num);
+        if (!checked) {
+          return std::nullopt;
+        }
+        product = *checked;
+      } else {
+        if (quotient > std::numeric_limits<work_type>::max() /
+                           static_cast<work_type>(num)) {
+          return std::nullopt;
+        }
+        product = quotient * static_cast<work_type>(num);
+      }
+    }
+
+    // The scaled remainder has the same sign as the product, or is zero.
+    const work_type rest = scale_int<Rounding, num, den>(remainder);
+    if (rest > 0 && product > std::numeric_limits<work_type>::max() - rest) {
+      return std::nullopt;
+    }
+    if constexpr (std::is_signed_v<work_type>) {
+      if (rest < 0 && product < std::numeric_limits<work_type>::min() - rest) {
+        return std::nullopt;
+      }
+    }
+    if (!std::in_range<ToRep>(product + rest)) {
+      return std::nullopt;
+    }
+    return product + rest;
+  }
+
+  /// Finds the value furthest from zero toward \p bound that converts without
+  /// overflow. Since zero converts to zero, and the result is monotonic, the
+  /// values between zero and the returned value all convert too.
+  constexpr static FromRep find_bound(work_type bound) {
+    work_type fits = 0;
+    while (fits != bound) {
+      // The midpoint, without overflow, and always one step past `fits`.
+      work_type mid = bound / 2 + fits / 2 + (bound % 2 + fits % 2) / 2;
+      if (mid == fits) {
+        mid = bound > fits ? fits + 1 : fits - 1;
+      }
+      if (scale_exact(mid)) {
+        fits = mid;
+      } else {
+        bound = bound > fits ? mid - 1 : mid + 1;
+      }
+    }
+    return static_cast<FromRep>(fits);
+  }
+
+  constexpr static FromRep find_min() {
+    if constexpr (is_exact) {
+      return find_bound(static_cast<work_type>(from_limits::min()));
+    } else {
+      return from_limits::min();
+    }
+  }
+
+  constexpr static FromRep find_max() {
+    if constexpr (is_exact) {
+      return find_bound(static_cast<work_type>(from_limits::max()));
+    } else {
+      return from_limits::max();
+    }
+  }
+
+public:
+  /// Smallest value that converts without overflow, if `is_exact`.
+  constexpr static FromRep min_value = find_min();
+
+  /// Largest value that converts without overflow, if `is_exact`.
+  constexpr static FromRep max_value = find_max();
+
+private:
+  /// Type of the scale if the value is not scaled exactly.
+  using float_type =
+      std::conditional_t<is_exact, long double,
+                         relaxed_scale_t<FromRep, ToRep, long double>>;
+
+  constexpr static float_type scale =
+      static_cast<float_type>(units_conversion_v<FromUnits, ToUnits>);
+
+  /// `2^digits`, one more than the maximum of `ToRep`.
+  constexpr static float_type to_top = [] {
+    float_type top = 1;
+    for (int i = 0; i < to_limits::digits; ++i) {
+      top *= 2;
+    }
+    return top;
+  }();
+
+  /// The minimum of `ToRep`: `-2^digits` if it is signed, else zero.
+  constexpr static float_type to_bottom = std::is_signed_v<ToRep> ? -to_top : 0;
+
+  /// True if every integral `FromRep` scales into the range of `ToRep` by a
+  /// margin wider than any rounding error.
+  constexpr static bool float_always_fits = [] {
+    if constexpr (!std::integral<FromRep> || is_exact) {
+      return false;
+    } else {
+      constexpr long double margin = 1 - 1.0l / (1 << 20);
+      const long double lo = static_cast<long double>(from_limits::min()) *
+                             static_cast<long double>(scale);
+      const long double hi = static_cast<long double>(from_limits::max()) *
+                             static_cast<long double>(scale);
+      const long double top = static_cast<long double>(to_top) * margin;
+      const long double bottom = std::is_signed_v<ToRep> ? -top : -0.5l;
+      return lo > bottom && lo < top && hi > bottom && hi < top;
+    }
+  }();
+
+  /// True if the scaled value \p p does not round below the minimum of
+  /// `ToRep`. This is false if \p p is NaN.
+  constexpr static bool above_bottom(float_type p) {
+    const float_type d = p - to_bottom;
+    if constexpr (Rounding == rounding::floor) {
+      return d >= 0;
+    } else if constexpr (Rounding == rounding::nearest) {
+      return d > float_type{-0.5};
+    } else {
+      return d > -1;
+    }
+  }
+
+  /// True if the scaled value \p p does not round above the maximum of
+  /// `ToRep`. This is false if \p p is NaN.
+  constexpr static bool below_top(float_type p) {
+    const float_type d = p - to_top;
+    if constexpr (Rounding == rounding::ceil) {
+      return d <= -1;
+    } else if constexpr (Rounding == rounding::nearest) {
+      return d < float_type{-0.5};
+    } else {
+      return d < 0;
+    }
+  }
+
+public:
+  /// True if every value of `FromRep` converts without overflow, so no check
+  /// is needed.
+  constexpr static bool always_fits =
+      is_exact ? min_value == from_limits::min() &&
+                     max_value == from_limits::max()
+               : float_always_fits;
+
+  /// True if \p value is below `min_value`. Not checked if every value is
+  /// above it.
+  constexpr static bool below_min(FromRep value) {
+    if constexpr (min_value == from_limits::min()) {
+      return false;
+    } else {
+      return value < min_value;
+    }
+  }
+
+  /// True if \p value is above `max_value`. Not checked if every value is
+  /// below it.
+  constexpr static bool above_max(FromRep value) {
+    if constexpr (max_value == from_limits::max()) {
+      return false;
+    } else {
+      return value > max_value;
+    }
+  }
+
+  /// Converts \p value, which must convert without overflow.
+  constexpr static ToRep convert(FromRep value) {
+    if constexpr (is_exact) {
+      return static_cast<ToRep>(
+          scale_int<Rounding, num, den>(static_cast<work_type>(value)));
+    } else {
+      return round_float<Rounding, ToRep>(static_cast<float_type>(value) *
+                                          scale);
+    }
+  }
+
+  /// Converts \p value, or returns `std::nullopt` if it overflows `ToRep`.
+  constexpr static std::optional<ToRep> checked(FromRep value) {
+    if constexpr (always_fits) {
+      return convert(value);
+    } else if constexpr (is_exact) {
+      if (below_min(value) || above_max(value)) {
+        return std::nullopt;
+      }
+      return convert(value);
+    } else {
+      const float_type p = static_cast<float_type>(value) * scale;
+      if (!above_bottom(p) || !below_top(p)) {
+        return std::nullopt;
+      }
+      return round_float<Rounding, ToRep>(p);
+    }
+  }
+
+  /// Converts \p value, or returns the nearest limit of `ToRep` if it
+  /// overflows. NaN converts to zero.
+  ///
+  /// Out-of-range values are clamped before they are converted, and the
+  /// limits are selected without branches, so loops can be vectorized.
+  constexpr static ToRep saturating(FromRep value) {
+    if constexpr (always_fits) {
+      return convert(value);
+    } else if constexpr (is_exact) {
+      constexpr ToRep low = is_increasing ? to_limits::min() : to_limits::max();
+      constexpr ToRep high =
+          is_increasing ? to_limits::max() : to_limits::min();
+      const bool below = below_min(value);
+      const bool above = above_max(value);
+      const ToRep result =
+          convert(below ? min_value : (above ? max_value : value));
+      return below ? low : (above ? high : result);
+    } else {
+      const float_type p = static_cast<float_type>(value) * scale;
+      const bool above = above_bottom(p);
+      const bool below = below_top(p);
+      const float_type clamped = above && below ? p : 0;
+      const ToRep result = round_float<Rounding, ToRep>(clamped);
+      return !above ? (below ? to_limits::min() : ToRep{0})
+                    : (below ? result : to_limits::max());
+    }
+  }
+};
+
+} // namespace detail
+
+/// Converts one quantity to another with an integral representation, or
+/// returns `std::nullopt` if the converted value does not fit.
+///
+/// Integral values are converted exactly in integer arithmetic when the
+/// conversion is an integer or a ratio of integers, such as from kilometers to
+/// millimeters. The range of values that convert without overflow is computed
+/// at compile time, so each value is checked by at most two comparisons, and
+/// not at all if every value of `FromRep` fits. Other values are scaled by a
+/// floating-point value, which is checked against the range of `ToRep` before
+/// it is rounded. NaN never fits.
+///
+/// \tparam ToRep Representation of the destination quantity.
+/// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round the converted value.
+/// \tparam FromRep Representation of the source quantity.
+/// \tparam FromUnits Units of the source quantity.
+/// \param from_quantity The source quantity.
+/// \return The destination quantity, as if converted by `quantity_cast`, or
+/// `std::nullopt` if its value is outside the range of `ToRep`.
+///
+template <std::integral ToRep, units ToUnits,
+          rounding Rounding = rounding::truncate, base_rep FromRep,
+          units FromUnits>
+requires units_convertible_to<FromUnits, ToUnits>
+constexpr std::optional<quantity<ToRep, ToUnits>>
+checked_quantity_cast(const quantity<FromRep, FromUnits> &from_quantity) {
+  using checked = detail::checked_conversion<FromRep, FromUnits, ToRep,
+                                             ToUnits, Rounding>;
+  if (const auto value = checked::checked(from_quantity.value())) {
+    return quantity<ToRep, ToUnits>{*value};
+  }
+  return std::nullopt;
+}
+
+/// Converts one quantity to another with an integral representation. If the
+/// converted value does not fit, it saturates to the nearest limit of `ToRep`.
+/// NaN converts to zero.
+///
+/// Values are converted as in `checked_quantity_cast`. Out-of-range values are
+/// clamped and replaced without branches, so loops of saturating casts can be
+/// vectorized.
+///
+/// \tparam ToRep Representation of the destination quantity.
+/// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round the converted value.
+/// \tparam FromRep Representation of the source quantity.
+/// \tparam FromUnits Units of the source quantity.
+/// \param from_quantity The source quantity.
+/// \return The destination quantity, with its value clamped to the range of
+/// `ToRep`.
+///
+template <std::integral ToRep, units ToUnits,
+          rounding Rounding = rounding::truncate, base_rep FromRep,
+          units FromUnits>
+requires units_convertible_to<FromUnits, ToUnits>
+constexpr quantity<ToRep, ToUnits>
+saturating_quantity_cast(const quantity<FromRep, FromUnits> &from_quantity) {
+  using checked = detail::checked_conversion<FromRep, FromUnits, ToRep,
+                                             ToUnits, Rounding>;
+  return quantity<ToRep, ToUnits>{checked::saturating(from_quantity.value())};
+}
+
+} // namespace mu
+
+#endif
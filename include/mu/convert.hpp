@@ -0,0 +1,116 @@
+#ifndef INCLUDED_MU_CONVERT_HPP
+#define INCLUDED_MU_CONVERT_HPP
+#include <algorithm>
+#include <cstddef>
+#include <mu/quantity.hpp>
+#include <mu/rep.hpp>
+#include <mu/units.hpp>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mu {
+
+namespace detail {
+
+/// Concept matches contiguous ranges of quantities with a known size, such as
+/// `std::span`, `std::vector` and `std::array` of quantities.
+///
+template <class Range>
+concept quantity_range = requires {
+  requires std::ranges::contiguous_range<Range>;
+  requires std::ranges::sized_range<Range>;
+  requires is_quantity_v<std::ranges::range_value_t<Range>>;
+};
+
+/// Quantity type of the elements of a `quantity_range`.
+///
+template <quantity_range Range>
+using range_quantity_t = std::ranges::range_value_t<Range>;
+
+/// Concept is `true` if the quantities of `FromRange` convert to the
+/// quantities of `ToRange` without loss of precision, and `ToRange` is
+/// writable.
+///
+template <class FromRange, class ToRange>
+concept quantity_range_convertible_to = requires {
+  requires quantity_range<FromRange>;
+  requires quantity_range<ToRange>;
+  requires std::ranges::output_range<ToRange, range_quantity_t<ToRange>>;
+  requires quantity_losslessly_convertible_to<
+      typename range_quantity_t<FromRange>::rep_type,
+      typename range_quantity_t<FromRange>::units_type,
+      typename range_quantity_t<ToRange>::rep_type,
+      typename range_quantity_t<ToRange>::units_type>;
+};
+
+/// Converts one quantity to another, as the converting constructor of
+/// `quantity` does. The scale is a compile-time constant of the relaxed scale
+/// type, so a loop of conversions multiplies every element by the same constant
+/// and can be vectorized.
+///
+template <class FromQuantity, class ToQuantity> struct rep_converter {
+  constexpr ToQuantity operator()(const FromQuantity &from) const {
+    return ToQuantity{
+        convert_losslessly<typename ToQuantity::rep_type,
+                           typename ToQuantity::units_type,
+                           typename FromQuantity::units_type>(from.value())};
+  }
+};
+
+/// Checks that \p to can hold as many quantities as \p from, and returns the
+/// subspan of \p to that the converted quantities are written to.
+///
+/// \throw std::length_error if \p to is smaller than \p from.
+///
+template <class FromQuantity, class ToQuantity>
+constexpr std::span<ToQuantity>
+conversion_output(std::span<const FromQuantity> from,
+                  std::span<ToQuantity> to) {
+  if (to.size() < from.size()) {
+    throw std::length_error("mu::convert output is smaller than its input");
+  }
+  return to.first(from.size());
+}
+
+} // namespace detail
+
+/// Converts a contiguous buffer of quantities to other units, or to another
+/// representation, without loss of precision.
+///
+/// Each element is converted as by the converting constructor of `quantity`.
+/// The scale is computed once at compile time, and the loop only reads and
+/// writes the representation values, so compilers vectorize it for the
+/// instruction set of the target. Overloads that take an execution policy are
+/// declared in `mu/execution.hpp`.
+///
+/// \param from The quantities to convert.
+/// \param to Destination of the converted quantities. Must be at least as large
+/// as \p from.
+/// \return The part of \p to that the converted quantities were written to.
+/// \throw std::length_error if \p to is smaller than \p from.
+///
+template <class FromRange, class ToRange>
+requires detail::quantity_range_convertible_to<FromRange, ToRange>
+constexpr std::span<detail::range_quantity_t<ToRange>>
+convert(const FromRange &from, ToRange &&to) {
+  using from_quantity = detail::range_quantity_t<FromRange>;
+  using to_quantity = detail::range_quantity_t<ToRange>;
+  const std::span<const from_quantity> in{from};
+  const std::span<to_quantity> out =
+      detail::conversion_output(in, std::span<to_quantity>{to});
+
+  const detail::rep_converter<from_quantity, to_quantity> converter;
+  const std::size_t count = in.size();
+  const from_quantity *in_data = in.data();
+  to_quantity *out_data = out.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    out_data[i] = converter(in_data[i]);
+  }
+  return out;
+}
+
+} // namespace mu
+
+#endif
@@ -1,10 +1,11 @@
 #ifndef INCLUDED_MU_DETAIL_ANALYSIS_HPP
 #define INCLUDED_MU_DETAIL_ANALYSIS_HPP
-#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <mu/detail/compute_pow.hpp>
-#include <mu/detail/concrete_factor.hpp>
 #include <mu/detail/primes.hpp>
-#include <mu/pow.hpp>
+#include <mu/detail/ratio.hpp>
+#include <mu/detail/signature.hpp>
 #include <mu/units.hpp>
 
 namespace mu::detail {
@@ -34,10 +35,20 @@ template <units FromUnits, units ToUnits> struct analysis {
   /// source quanity by an integer.
   bool is_int_convertible = true;
 
+  /// True if `FromUnits` can be converted to `ToUnits` by multiplying the
+  /// source quantity by an integer, then dividing it by another integer. This
+  /// is true whenever `is_int_convertible` is true.
+  bool is_ratio_convertible = true;
+
   /// If the conversion is convertible by an integer, this holds the integer
-  /// conversion value.
+  /// conversion value. If it is convertible by a ratio, this holds the
+  /// numerator of the ratio.
   std::intmax_t int_conversion = 1;
 
+  /// If the conversion is convertible by a ratio, this holds the positive
+  /// denominator of the ratio. It is 1 if the conversion is int-convertible.
+  std::intmax_t int_divisor = 1;
+
   /// If the conversion is NOT convertible by an integer, this holds the
   /// floating-point conversion value.
   long double float_conversion = 1.0;
@@ -45,112 +56,210 @@ template <units FromUnits, units ToUnits> struct analysis {
   /// The constructor performs dimensional analysis of the conversion from
   /// `FromUnits` to `ToUnits`.
   constexpr analysis() {
-    // Divide FromUnits by ToUnits, and obtain concrete factors for each factor
-    // in the quotient.
-    using quotient = mult<FromUnits, pow<ToUnits, -1>>;
-    using quotient_factors = typename unit_traits<quotient>::factors;
-    using generator = concrete_factor_generator<quotient_factors>;
-    auto concrete_factors = generator::make_concrete_factors();
-
-    // Scan all the concrete factors. Sum exponents of factors with the same
-    // base.
-    std::array<concrete_factor, generator::max_id> combined_factors;
-    for (const auto &f : concrete_factors) {
-      combine_factors(combined_factors[f.base_id], f);
-    }
-
-    // Track the prime-factorization of rational factors.
-    std::vector<prime_factor> prime_factors;
-
-    // Scan the combined factors.
-    for (const auto &f : combined_factors) {
-      if (f.base_id == UNKNOWN_BASE_ID || f.exponent.is_zero()) {
-        continue;
-      }
-      if (f.is_dimensional) {
-        // Found a combined *dimensional* factor with a non-zero exponent.
-        // FromUnits and ToUnits have different dimensions, and are not
-        // convertible.
-        set_not_convertible();
-        return;
-      }
-      if (!f.is_rational_value) {
-        // Found a combined *irrational* factor with a non-zero exponent. This
-        // guarantees that FromUnits cannot be converted to ToUnits without
-        // multiplying by some floating point conversion value.
-        if (!scale_by_float(f.irrational_value, f.exponent)) {
-          set_not_convertible();
-          return;
-        }
-      } else {
-        // Found a *rational* factor. Break it into prime factors.
-        prime_factorize(prime_factors, f.rational_value, f.exponent);
-      }
+    // Divide FromUnits by ToUnits by merging their signatures. Each signature
+    // is computed once per unit expression, so only the merge is specific to
+    // this pair.
+    constexpr const auto &from = units_signature_object<FromUnits>;
+    constexpr const auto &to = units_signature_object<ToUnits>;
+
+    // Sum exponents of terms with the same base. A matched term of `to` is
+    // added into the term of `from`, and its own exponent is cleared.
+    std::array<ratio, from.terms.size()> from_exponents;
+    for (std::size_t i = 0; i < from.terms.size(); ++i) {
+      from_exponents[i] = from.terms[i].exponent;
+    }
+    std::array<ratio, to.terms.size()> to_exponents;
+    for (std::size_t i = 0; i < to.terms.size(); ++i) {
+      to_exponents[i] = -to.terms[i].exponent;
+    }
+    merge_terms(from, to, from_exponents, to_exponents);
+
+    // Scan the combined terms: first those of FromUnits, then those only in
+    // ToUnits. Rational terms are handled by the prime factors below.
+    if (!scale_by_terms(from, from_exponents) ||
+        !scale_by_terms(to, to_exponents)) {
+      set_not_convertible();
+      return;
     }
 
     // Combine prime factors, and calculate their contribution to the unit
     // conversion value.
-    combine_prime_factors(prime_factors);
-    for (auto &f : prime_factors) {
-      if (f.base == -1) {
-        // The conversion includes a negative factor.
-        if (!scale_by_negative_1(f.exponent)) {
-          set_not_convertible();
-          return;
-        }
-      } else if (!f.exponent.is_negative() && f.exponent.is_whole()) {
-        // This factor only requires int conversion.
-        if (!scale_by_int(f.base, f.exponent.num / f.exponent.den)) {
-          set_not_convertible();
-          return;
-        }
-      } else {
-        // This factor requires float conversion.
-        if (!scale_by_float(static_cast<long double>(f.base), f.exponent)) {
-          set_not_convertible();
-          return;
-        }
-      }
+    if (!scale_by_primes(from, to)) {
+      set_not_convertible();
+      return;
     }
 
     // Determine if units are equivalent, and if they are int-convertible.
     if (float_conversion != 1.0) {
       is_equivalent = false;
       is_int_convertible = false;
+      is_ratio_convertible = false;
       float_conversion *= int_conversion;
+      float_conversion /= int_divisor;
       if (is_infinity(float_conversion)) {
         set_not_convertible();
       }
       return;
     }
+    if (int_divisor != 1) {
+      is_equivalent = false;
+      is_int_convertible = false;
+      float_conversion = static_cast<long double>(int_conversion) /
+                         static_cast<long double>(int_divisor);
+      return;
+    }
     if (int_conversion != 1) {
       is_equivalent = false;
     }
   }
 
 private:
-  /// Multiply the exponent of \p src into \p dst. If \p dst has an unkown
-  /// base_id, then copy \p src into \p dst.
-  ///
-  constexpr static void combine_factors(concrete_factor &dst,
-                                        const concrete_factor &src) {
-    if (dst.base_id == src.base_id) {
-      dst.exponent += src.exponent;
-    } else {
-      dst.base_id = src.base_id;
-      dst.exponent = src.exponent;
-      dst.is_dimensional = src.is_dimensional;
-      dst.is_rational_value = src.is_rational_value;
-      dst.rational_value = src.rational_value;
-      dst.irrational_value = src.irrational_value;
+  /// Adds the exponent of each term of \p to into the term of \p from with the
+  /// same base, if any, and clears it. Both signatures are walked in order of
+  /// base hash, so this is linear in the number of terms.
+  ///
+  template <class FromSignature, class ToSignature, class FromExponents,
+            class ToExponents>
+  constexpr static void merge_terms(const FromSignature &from,
+                                    const ToSignature &to,
+                                    FromExponents &from_exponents,
+                                    ToExponents &to_exponents) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < from.terms.size() && j < to.terms.size()) {
+      auto hash = from.terms[from.hash_order[i]].base_hash;
+      auto to_hash = to.terms[to.hash_order[j]].base_hash;
+      if (hash < to_hash) {
+        ++i;
+        continue;
+      }
+      if (to_hash < hash) {
+        ++j;
+        continue;
+      }
+
+      // Distinct bases may share a hash. Match the bases within the run of
+      // equal hashes by their type ids.
+      std::size_t i_end = i;
+      while (i_end < from.terms.size() &&
+             from.terms[from.hash_order[i_end]].base_hash == hash) {
+        ++i_end;
+      }
+      std::size_t j_end = j;
+      while (j_end < to.terms.size() &&
+             to.terms[to.hash_order[j_end]].base_hash == hash) {
+        ++j_end;
+      }
+      for (; i < i_end; ++i) {
+        std::size_t f = from.hash_order[i];
+        for (std::size_t k = j; k < j_end; ++k) {
+          std::size_t t = to.hash_order[k];
+          if (from.terms[f].base_type_id == to.terms[t].base_type_id) {
+            from_exponents[f] += to_exponents[t];
+            to_exponents[t] = 0;
+          }
+        }
+      }
+      j = j_end;
     }
   }
 
+  /// Scales the conversion by the non-rational terms of \p signature, raised
+  /// to \p exponents.
+  ///
+  /// \return false if a dimensional term has a non-zero exponent, or if the
+  /// scaling is undefined.
+  ///
+  template <class Signature, class Exponents>
+  constexpr bool scale_by_terms(const Signature &signature,
+                                const Exponents &exponents) {
+    for (std::size_t i = 0; i < signature.terms.size(); ++i) {
+      const auto &f = signature.terms[i];
+      if (exponents[i].is_zero()) {
+        continue;
+      }
+      if (f.is_dimensional) {
+        // Found a combined *dimensional* factor with a non-zero exponent.
+        // FromUnits and ToUnits have different dimensions, and are not
+        // convertible.
+        return false;
+      }
+      if (!f.is_rational_value) {
+        // Found a combined *irrational* factor with a non-zero exponent. This
+        // guarantees that FromUnits cannot be converted to ToUnits without
+        // multiplying by some floating point conversion value.
+        if (!scale_by_float(f.irrational_value, exponents[i])) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Scales the conversion by the prime factors of \p from, divided by the
+  /// prime factors of \p to. Both are sorted by prime, so they are merged in
+  /// linear time.
+  ///
+  /// \return false if the scaling is undefined or overflows.
+  ///
+  template <class FromSignature, class ToSignature>
+  constexpr bool scale_by_primes(const FromSignature &from,
+                                 const ToSignature &to) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < from.primes.size() || j < to.primes.size()) {
+      prime_factor f;
+      if (j == to.primes.size() ||
+          (i < from.primes.size() && from.primes[i] < to.primes[j])) {
+        f = from.primes[i++];
+      } else if (i == from.primes.size() || to.primes[j] < from.primes[i]) {
+        f = prime_factor{to.primes[j].base, -to.primes[j].exponent};
+        ++j;
+      } else {
+        f = from.primes[i++];
+        f.exponent += -to.primes[j++].exponent;
+        if (f.exponent.is_zero()) {
+          continue;
+        }
+      }
+      if (!scale_by_prime(f)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Scales the conversion by a combined prime factor.
+  ///
+  /// \return false if the scaling is undefined or overflows.
+  ///
+  constexpr bool scale_by_prime(const prime_factor &f) {
+    if (f.base == -1) {
+      // The conversion includes a negative factor.
+      return scale_by_negative_1(f.exponent);
+    }
+    if (f.exponent.is_whole()) {
+      const std::intmax_t exponent = f.exponent.num / f.exponent.den;
+      if (exponent > 0) {
+        // This factor only requires int conversion.
+        return scale_by_int(f.base, exponent);
+      }
+      // This factor divides the conversion by an integer. If the divisor
+      // overflows, the factor is applied as a float instead.
+      if (scale_by_int_divisor(f.base, -exponent)) {
+        return true;
+      }
+    }
+    // This factor requires float conversion.
+    return scale_by_float(static_cast<long double>(f.base), f.exponent);
+  }
+
   /// Puts this object in the "not convertible" state.
   constexpr void set_not_convertible() {
     is_convertible = false;
     is_equivalent = false;
     is_int_convertible = false;
+    is_ratio_convertible = false;
     return;
   }
 
@@ -169,6 +278,22 @@ private:
     return false;
   }
 
+  /// Scale the integer divisor by an integer raised to an integer power.
+  ///
+  /// \return false if the exponentiation or scaling would result in integer
+  /// overflow. In this case, the divisor is unchanged.
+  ///
+  constexpr bool scale_by_int_divisor(std::intmax_t value,
+                                      std::intmax_t exponent) {
+    if (auto checked_pow = compute_whole_pow_int(value, exponent)) {
+      if (auto checked_mult = safe_mult(int_divisor, *checked_pow)) {
+        int_divisor = *checked_mult;
+        return true;
+      }
+    }
+    return false;
+  }
+
   /// Scale the float conversion by a float raised to a rational exponent.
   ///
   /// \return false if the scaling is undefined (divide by 0, or even root of
@@ -0,0 +1,46 @@
+#ifndef INCLUDED_MU_DETAIL_CANONICAL_HPP
+#define INCLUDED_MU_DETAIL_CANONICAL_HPP
+#include <mu/detail/simplify.hpp>
+#include <mu/units.hpp>
+
+namespace mu::detail {
+
+/// Unwraps a product of a single term.
+template <class Units> struct unwrap_single_term {
+  using type = Units;
+};
+
+template <class Term> struct unwrap_single_term<mult<Term>> {
+  using type = Term;
+};
+
+/// The canonical normal form of a unit expression.
+///
+/// The expression is flattened into terms in the same way as `simplify_units`,
+/// terms with the same atom are combined, and terms whose exponents sum to zero
+/// are dropped. The remaining terms are sorted by the `type_key` of their
+/// atoms, so equivalent products written in a different order (e.g.
+/// `mult<meter, second>` and `mult<second, meter>`) have the same canonical
+/// form. A single term is not wrapped in a `mult`.
+///
+/// Named units are never decomposed, so canonical forms stay readable. As a
+/// consequence, units that are equivalent only after factorization (e.g.
+/// `newton` and `mult<kilogram, meter, per<second, 2>>`) keep distinct
+/// canonical forms.
+///
+/// The result is flat: its depth does not grow with the number of operations
+/// that produced the original expression.
+///
+/// \tparam Units The unit expression to canonicalize.
+///
+template <class Units> struct canonical_units {
+  using type = typename unwrap_single_term<typename combine_display_terms<
+      display_terms_t<Units>, display_term_order::type_key>::type>::type;
+};
+
+template <class Units>
+using canonical_units_t = typename canonical_units<Units>::type;
+
+} // namespace mu::detail
+
+#endif
@@ -1,9 +1,14 @@
 #ifndef INCLUDED_MU_DETAIL_CONCRETE_FACTOR_HPP
 #define INCLUDED_MU_DETAIL_CONCRETE_FACTOR_HPP
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <mu/detail/factor.hpp>
+#include <mu/detail/primes.hpp>
 #include <mu/detail/ratio.hpp>
+#include <mu/detail/type_key.hpp>
 #include <mu/units.hpp>
 
 namespace mu::detail {
@@ -22,13 +27,23 @@ constexpr concrete_factor_base_id UNKNOWN_BASE_ID =
 /// store a type as a member, but it can store a unique id for that type. The id
 /// is assigned by the concrete_factor_generator type.
 ///
+/// The base_id is only meaningful within one generator. To match bases across
+/// generators, the concrete factor also stores the `type_hash` and `type_id` of
+/// its base type.
+///
 struct concrete_factor {
   concrete_factor_base_id base_id = UNKNOWN_BASE_ID;
+  std::uint64_t base_hash = 0;
+  const void *base_type_id = nullptr;
   ratio exponent = 0;
   bool is_dimensional = false;
   bool is_rational_value = 1;
   ratio rational_value = 1;
   long double irrational_value = 1.0;
+
+  /// If the factor is not dimensional and its value is rational, this is the
+  /// shared prime factorization of `rational_value`. Otherwise, it is null.
+  const ratio_prime_factors_type *rational_primes = nullptr;
 };
 
 /// Factory that can generate an array of concrete factors from a type-list of
@@ -43,6 +58,40 @@ template <class FactorList> class concrete_factor_generator {};
 /// The only supported specialization of concrete_factor_generator.
 template <factor... Factors> class concrete_factor_generator<mult<Factors...>> {
 private:
+  /// The base type of a factor, identified by its `type_hash` and `type_id`,
+  /// and the index of the factor in `Factors...`.
+  struct base_entry {
+    std::uint64_t hash = 0;
+    const void *id = nullptr;
+    concrete_factor_base_id index = UNKNOWN_BASE_ID;
+  };
+
+  /// Orders entries by hash, then by index.
+  constexpr static bool entry_less(const base_entry &lhs,
+                                   const base_entry &rhs) {
+    return lhs.hash < rhs.hash ||
+           (lhs.hash == rhs.hash && lhs.index < rhs.index);
+  }
+
+  /// Builds the entries for every factor, sorted by `entry_less`.
+  constexpr static std::array<base_entry, sizeof...(Factors)>
+  make_base_index() {
+    std::array<base_entry, sizeof...(Factors)> entries{
+        base_entry{type_hash<typename factor_traits<Factors>::base>,
+                   type_id<typename factor_traits<Factors>::base>}...};
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      entries[i].index = i;
+    }
+    std::sort(entries.begin(), entries.end(), entry_less);
+    return entries;
+  }
+
+  /// Factor bases, sorted by hash. Each base id is found by binary search, so
+  /// assigning ids to all factors takes O(N log N) integer comparisons and
+  /// O(N) instantiations, instead of comparing every pair of factor types.
+  constexpr static std::array<base_entry, sizeof...(Factors)> base_index =
+      make_base_index();
+
   /// Compute the base id for a base type by locating the first index of
   /// `Factors...` whose base is the requested type.
   ///
@@ -52,12 +101,19 @@ private:
   ///
   template <class FactorBase>
   constexpr static concrete_factor_base_id get_base_id() {
-    concrete_factor_base_id id = 0;
-    bool found =
-        ((++id,
-          std::is_same_v<FactorBase, typename factor_traits<Factors>::base>) ||
-         ...);
-    return found ? (id - 1) : UNKNOWN_BASE_ID;
+    constexpr base_entry requested{type_hash<FactorBase>,
+                                   type_id<FactorBase>, 0};
+    // Entries with the same hash are ordered by index, so the first entry
+    // whose id matches holds the first index. Other types in the range are
+    // hash collisions.
+    for (auto it = std::lower_bound(base_index.begin(), base_index.end(),
+                                    requested, entry_less);
+         it != base_index.end() && it->hash == requested.hash; ++it) {
+      if (it->id == requested.id) {
+        return it->index;
+      }
+    }
+    return UNKNOWN_BASE_ID;
   }
 
   /// Construct a concrete factor from a factor type. The factor must appear in
@@ -66,12 +122,20 @@ private:
   template <factor Factor>
   constexpr static concrete_factor make_concrete_factor() {
     concrete_factor f;
-    f.base_id = base_id<typename factor_traits<Factor>::base>;
+    using base = typename factor_traits<Factor>::base;
+    f.base_id = base_id<base>;
+    f.base_hash = type_hash<base>;
+    f.base_type_id = type_id<base>;
     f.exponent = factor_traits<Factor>::exponent;
     f.is_dimensional = factor_traits<Factor>::is_dimensional;
     f.is_rational_value = factor_traits<Factor>::is_rational_value;
     f.rational_value = factor_traits<Factor>::rational_value;
     f.irrational_value = factor_traits<Factor>::irrational_value;
+    if constexpr (!factor_traits<Factor>::is_dimensional &&
+                  factor_traits<Factor>::is_rational_value) {
+      constexpr ratio value = factor_traits<Factor>::rational_value;
+      f.rational_primes = &ratio_prime_factors<value.num, value.den>;
+    }
     return f;
   }
 
@@ -96,6 +160,18 @@ public:
   }
 };
 
+/// Multiply the exponent of \p src into \p dst. If \p dst has a different
+/// base_id, then copy \p src into \p dst.
+///
+constexpr void combine_concrete_factors(concrete_factor &dst,
+                                        const concrete_factor &src) {
+  if (dst.base_id == src.base_id) {
+    dst.exponent += src.exponent;
+  } else {
+    dst = src;
+  }
+}
+
 } // namespace mu::detail
 
 #endif
\ No newline at end of file
@@ -2,9 +2,13 @@
 #define INCLUDED_MU_DETAIL_PRIMES_HPP
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
 #include <mu/detail/ratio.hpp>
-#include <vector>
+#include <mu/detail/static_vector.hpp>
 
 namespace mu::detail {
 
@@ -51,12 +55,37 @@ struct prime_factor {
   }
 };
 
+/// The greatest number of distinct primes whose product fits in a
+/// `std::intmax_t`. A whole number never has more prime factors than this.
+constexpr std::size_t MAX_DISTINCT_PRIME_FACTORS = [] {
+  std::size_t count = 0;
+  std::intmax_t product = 1;
+  for (std::intmax_t prime : PRIMES_TABLE) {
+    if (product > std::numeric_limits<std::intmax_t>::max() / prime) {
+      break;
+    }
+    product *= prime;
+    ++count;
+  }
+  return count;
+}();
+
+/// The greatest number of prime factors that one call to `prime_factorize`
+/// appends: a factor of -1, plus the factors of the numerator and of the
+/// denominator.
+constexpr std::size_t MAX_PRIME_FACTORS_PER_RATIO =
+    1 + 2 * MAX_DISTINCT_PRIME_FACTORS;
+
 /// If `candidate_prime` divides `value`, append `candidate_prime` to the `out`
 /// vector, raised by the provided `exponent`. If `candidate_prime` divides
 /// `value` more than once, the exponent is increased accordingly.
 ///
-constexpr void try_prime_factor(std::vector<prime_factor> &out,
-                                std::intmax_t &value, ratio exponent,
+/// \tparam PrimeFactors A vector-like container of `prime_factor`, such as
+/// `static_vector` or `std::vector`.
+///
+template <class PrimeFactors>
+constexpr void try_prime_factor(PrimeFactors &out, std::intmax_t &value,
+                                ratio exponent,
                                 std::intmax_t candidate_prime) {
   if (value % candidate_prime != 0) {
     // Prime does not divide value.
@@ -76,17 +105,177 @@ constexpr void try_prime_factor(std::vector<prime_factor> &out,
   out.push_back(current);
 }
 
+/// Computes `(lhs + rhs) % modulus`. Requires `lhs` and `rhs` less than
+/// `modulus`, and `modulus` no greater than the maximum `std::intmax_t`.
+constexpr std::uintmax_t add_mod(std::uintmax_t lhs, std::uintmax_t rhs,
+                                 std::uintmax_t modulus) {
+  const std::uintmax_t sum = lhs + rhs;
+  return sum >= modulus ? sum - modulus : sum;
+}
+
+/// Computes `(lhs * rhs) % modulus` without overflow. Requires `lhs` and `rhs`
+/// less than `modulus`, and `modulus` no greater than the maximum
+/// `std::intmax_t`.
+///
+/// Without a 128-bit integer type, this falls back to doubling and adding,
+/// which is much slower to evaluate at compile time.
+///
+constexpr std::uintmax_t mul_mod(std::uintmax_t lhs, std::uintmax_t rhs,
+                                 std::uintmax_t modulus) {
+#ifdef __SIZEOF_INT128__
+  __extension__ using wide = unsigned __int128;
+  return static_cast<std::uintmax_t>(wide{lhs} * rhs % modulus);
+#else
+  std::uintmax_t product = 0;
+  for (; rhs != 0; rhs >>= 1) {
+    if (rhs & 1) {
+      product = add_mod(product, lhs, modulus);
+    }
+    lhs = add_mod(lhs, lhs, modulus);
+  }
+  return product;
+#endif
+}
+
+/// Computes `(base ^ exponent) % modulus`. Requires `base` less than `modulus`.
+constexpr std::uintmax_t pow_mod(std::uintmax_t base, std::uintmax_t exponent,
+                                 std::uintmax_t modulus) {
+  std::uintmax_t result = 1;
+  for (; exponent != 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = mul_mod(result, base, modulus);
+    }
+    base = mul_mod(base, base, modulus);
+  }
+  return result;
+}
+
+/// True if `value` is prime. Requires `value` to have no prime factors in the
+/// `PRIMES_TABLE`.
+///
+/// Uses Miller-Rabin with the first 12 primes as witnesses, which is exact for
+/// every value below 3.3 * 10^24.
+///
+constexpr bool is_large_prime(std::uintmax_t value) {
+  constexpr std::intmax_t next_prime = 547;
+  static_assert(PRIMES_TABLE.back() < next_prime);
+  if (value < static_cast<std::uintmax_t>(next_prime * next_prime)) {
+    // No prime factor can be greater than the square root of value.
+    return value > 1;
+  }
+
+  // Write value - 1 as odd * 2^twos.
+  std::uintmax_t odd = value - 1;
+  int twos = 0;
+  for (; odd % 2 == 0; odd /= 2) {
+    ++twos;
+  }
+
+  for (std::size_t i = 0; i < 12; ++i) {
+    std::uintmax_t x = pow_mod(PRIMES_TABLE[i], odd, value);
+    if (x == 1 || x == value - 1) {
+      continue;
+    }
+    int square = 1;
+    for (; square < twos; ++square) {
+      x = mul_mod(x, x, value);
+      if (x == value - 1) {
+        break;
+      }
+    }
+    if (square == twos) {
+      // This witness proves value is composite.
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Finds a non-trivial divisor of `value` with Brent's variant of Pollard's rho
+/// algorithm. Requires `value` to be composite, with no prime factors in the
+/// `PRIMES_TABLE`.
+///
+constexpr std::uintmax_t find_large_divisor(std::uintmax_t value) {
+  // Differences are multiplied together in batches of this many, so gcd is
+  // computed once per batch instead of once per step.
+  constexpr std::uintmax_t batch_size = 64;
+
+  for (std::uintmax_t c = 1;; ++c) {
+    const auto step = [=](std::uintmax_t x) {
+      return add_mod(mul_mod(x, x, value), c, value);
+    };
+    const auto distance = [](std::uintmax_t x, std::uintmax_t y) {
+      return x > y ? x - y : y - x;
+    };
+
+    std::uintmax_t x = 2;
+    std::uintmax_t y = 2;
+    std::uintmax_t saved_y = 2;
+    std::uintmax_t product = 1;
+    std::uintmax_t divisor = 1;
+    for (std::uintmax_t cycle = 1; divisor == 1; cycle *= 2) {
+      x = y;
+      for (std::uintmax_t i = 0; i < cycle; ++i) {
+        y = step(y);
+      }
+      for (std::uintmax_t k = 0; k < cycle && divisor == 1; k += batch_size) {
+        saved_y = y;
+        for (std::uintmax_t i = 0; i < batch_size && i < cycle - k; ++i) {
+          y = step(y);
+          product = mul_mod(product, distance(x, y), value);
+        }
+        divisor = std::gcd(product, value);
+      }
+    }
+
+    if (divisor == value) {
+      // The batch overshot. Repeat its steps one at a time.
+      do {
+        saved_y = step(saved_y);
+        divisor = std::gcd(distance(x, saved_y), value);
+      } while (divisor == 1);
+    }
+
+    if (divisor != value) {
+      return divisor;
+    }
+    // The sequence cycled without finding a divisor. Try another one.
+  }
+}
+
+/// Appends the prime factors of `value` to `out`, with repetition, as
+/// `std::intmax_t`. Requires `value` to have no prime factors in the
+/// `PRIMES_TABLE`.
+template <class Primes>
+constexpr void factorize_large_primes(Primes &out, std::uintmax_t value) {
+  if (value == 1) {
+    return;
+  }
+  if (is_large_prime(value)) {
+    out.push_back(static_cast<std::intmax_t>(value));
+    return;
+  }
+  const std::uintmax_t divisor = find_large_divisor(value);
+  factorize_large_primes(out, divisor);
+  factorize_large_primes(out, value / divisor);
+}
+
 /// Appends the prime factors of `value` raised by `exponent` to the output
 /// vector. This effectively prime-factorizes `value`, and raises each prime
 /// factor by the provided exponent.
 ///
+/// Small primes are found by trial division over the `PRIMES_TABLE`. Whatever
+/// remains is factorized exactly with Pollard's rho algorithm, so the result is
+/// correct for every `std::intmax_t`.
+///
 /// \param out Push prime_factors into this vector
 /// \param value The value to factorize. Must be greater than 0.
 /// \param exponent The value is already rasied to this exponent. The value will
 /// be factored independently, then this exponent will be applied to all the
 /// prime factors.
 ///
-constexpr void prime_factorize_whole_number(std::vector<prime_factor> &out,
+template <class PrimeFactors>
+constexpr void prime_factorize_whole_number(PrimeFactors &out,
                                             std::intmax_t &value,
                                             ratio exponent) {
 
@@ -100,17 +289,36 @@ constexpr void prime_factorize_whole_number(std::vector<prime_factor> &out,
 
     // Test each prime in the batch.
     const std::size_t batch_end = i + PRIMES_TABLE_BATCH_SIZE;
-    for (std::size_t j = 0; j < batch_end; ++j) {
+    for (std::size_t j = i; j < batch_end; ++j) {
       try_prime_factor(out, value, exponent, PRIMES_TABLE[j]);
     }
   }
 
-  // If there is any remaining value, that means no primes in the table could
-  // divide this value. Let's **ASSUME** the remaining portion is a prime
-  // number.
-  if (value > 1) {
-    out.emplace_back(value, exponent);
+  if (value == 1) {
+    return;
   }
+
+  // Any remaining value is a product of primes beyond the table. Every such
+  // prime exceeds 541, so there are at most 6 of them.
+  static_vector<std::intmax_t, 6> large_primes;
+  factorize_large_primes(large_primes, static_cast<std::uintmax_t>(value));
+  // Insertion sort, since there are so few. GCC 12 warns that std::sort reads
+  // past the end of the buffer in optimized builds.
+  for (std::size_t i = 1; i < large_primes.size(); ++i) {
+    for (std::size_t j = i; j > 0 && large_primes[j] < large_primes[j - 1];
+         --j) {
+      std::swap(large_primes[j], large_primes[j - 1]);
+    }
+  }
+  for (std::size_t i = 0; i < large_primes.size();) {
+    prime_factor current(large_primes[i]);
+    for (; i < large_primes.size() && large_primes[i] == current.base; ++i) {
+      current.exponent.num++;
+    }
+    current.exponent *= exponent;
+    out.push_back(current);
+  }
+  value = 1;
 }
 
 /// Factorizes a number of the form `base ^ exponent` where `base` and
@@ -122,10 +330,9 @@ constexpr void prime_factorize_whole_number(std::vector<prime_factor> &out,
 /// If `base` is a negative value, then this method pushes a factor of
 /// `-1^exponent` followed by the factorization of `|base|`.
 ///
-/// The prime-factorization algorithm does NOT calculate prime numbers, but
-/// instead sources candidate primes from the `PRIMES_TABLE` earlier in this
-/// file. If an input is the product of primes not found in that table, then
-/// those primes will NOT appear in the factorization.
+/// The factorization is exact for every numerator and denominator. Primes
+/// from the `PRIMES_TABLE` earlier in this file are found by trial division,
+/// and any larger primes by Pollard's rho algorithm.
 ///
 /// This function assumes as preconditions:
 ///   1. base is nonzero
@@ -141,8 +348,8 @@ constexpr void prime_factorize_whole_number(std::vector<prime_factor> &out,
 ///   - The resulting factors, in order, are:
 ///     {-1^2/3, 2*2/3, 7^4/3, 2^-4/3, 3^-4/3}.
 ///
-constexpr void prime_factorize(std::vector<prime_factor> &out, ratio base,
-                               ratio exponent) {
+template <class PrimeFactors>
+constexpr void prime_factorize(PrimeFactors &out, ratio base, ratio exponent) {
   base.normalize_sign();
   if (base.num < 0) {
     // Push a factor of -1, then factorize the positive value instead.
@@ -154,47 +361,52 @@ constexpr void prime_factorize(std::vector<prime_factor> &out, ratio base,
 }
 
 /// Given an output vector from one or more calls to `prime_factorize`, modify
-/// it so factors of the same base have their exponents combined. The combined
-/// exponents are not simplified.
+/// it so factors of the same base have their exponents combined, and factors
+/// whose combined exponents are zero are removed. The combined exponents are
+/// not simplified.
 ///
-constexpr void combine_prime_factors(std::vector<prime_factor> &prime_factors) {
-  if (prime_factors.empty()) {
-    return;
-  }
-
-  // Combine factors with the same base.
+/// The factors are sorted, then merged in place in a single pass, so no
+/// element is erased from the middle of the vector.
+///
+template <class PrimeFactors>
+constexpr void combine_prime_factors(PrimeFactors &prime_factors) {
   std::sort(prime_factors.begin(), prime_factors.end());
-  auto it = prime_factors.begin();
-  auto cur = it;
-  ++it;
-  bool combine = false;
-  while (it != prime_factors.end()) {
-    if (it->base == cur->base) {
-      cur->exponent += it->exponent;
-      combine = true;
-      ++it;
-      continue;
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < prime_factors.size();) {
+    prime_factor combined = prime_factors[i];
+    for (++i; i < prime_factors.size() &&
+              prime_factors[i].base == combined.base;
+         ++i) {
+      combined.exponent += prime_factors[i].exponent;
     }
-    if (combine) {
-      if (!cur->exponent.is_zero()) {
-        ++cur;
-      }
-      it = prime_factors.erase(cur, it);
-      combine = false;
-    }
-    cur = it;
-    ++it;
-  }
-  if (combine) {
-    if (!cur->exponent.is_zero()) {
-      ++cur;
+    if (!combined.exponent.is_zero()) {
+      prime_factors[size++] = combined;
     }
-    prime_factors.erase(cur, it);
-  } else if (cur->exponent.is_zero()) {
-    prime_factors.erase(cur, it);
   }
+  prime_factors.resize(size);
 }
 
+/// The prime factors of one rational value, as produced by `prime_factorize`.
+using ratio_prime_factors_type =
+    static_vector<prime_factor, MAX_PRIME_FACTORS_PER_RATIO>;
+
+/// The prime factorization of `Num / Den`, computed once per value.
+///
+/// Every rational factor with this value shares the same factorization, so
+/// trial division runs once per distinct value in a translation unit, however
+/// many unit expressions use it. To factorize the value raised to an exponent,
+/// multiply the exponent of each prime factor by it.
+///
+/// \tparam Num Numerator of the value. Must not be zero.
+/// \tparam Den Denominator of the value. Must not be zero.
+///
+template <std::intmax_t Num, std::intmax_t Den>
+constexpr ratio_prime_factors_type ratio_prime_factors = [] {
+  ratio_prime_factors_type out;
+  prime_factorize(out, ratio{Num, Den}, 1);
+  return out;
+}();
+
 } // namespace mu::detail
 
 #endif
\ No newline at end of file
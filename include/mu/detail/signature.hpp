@@ -0,0 +1,145 @@
+#ifndef INCLUDED_MU_DETAIL_SIGNATURE_HPP
+#define INCLUDED_MU_DETAIL_SIGNATURE_HPP
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mu/detail/concrete_factor.hpp>
+#include <mu/detail/primes.hpp>
+#include <mu/detail/static_vector.hpp>
+#include <mu/units.hpp>
+
+namespace mu::detail {
+
+/// The canonical signature of a unit expression: its factors combined by base,
+/// and the prime factorization of its rational scale.
+///
+/// Signatures are computed once per unit expression. Dimensional analysis
+/// between two unit expressions then merges their signatures, instead of
+/// factorizing the quotient of the two expressions.
+///
+/// \tparam TermCount Number of distinct factor bases.
+/// \tparam PrimeCount Number of prime factors in the rational scale.
+///
+template <std::size_t TermCount, std::size_t PrimeCount>
+struct units_signature {
+  /// One combined factor per base, in order of first appearance. Terms with
+  /// rational values are also included in `primes`.
+  std::array<concrete_factor, TermCount> terms{};
+
+  /// Indices into `terms`, ordered by `concrete_factor::base_hash`.
+  std::array<std::size_t, TermCount> hash_order{};
+
+  /// Prime factorization of the rational terms with non-zero exponents,
+  /// combined and sorted by prime. No prime has a zero exponent.
+  std::array<prime_factor, PrimeCount> primes{};
+};
+
+/// Computes the signature of a unit expression.
+///
+/// \tparam Units The unit expression.
+///
+template <units Units> class units_signature_builder {
+private:
+  using generator =
+      concrete_factor_generator<typename unit_traits<Units>::factors>;
+
+  constexpr static std::size_t factor_count = generator::max_id;
+
+  /// Combines the concrete factors by base. Entry `i` holds the combined
+  /// factor if `i` is the base id of its base.
+  constexpr static std::array<concrete_factor, factor_count> combine() {
+    std::array<concrete_factor, factor_count> combined;
+    for (const auto &f : generator::make_concrete_factors()) {
+      combine_concrete_factors(combined[f.base_id], f);
+    }
+    return combined;
+  }
+
+  constexpr static std::array<concrete_factor, factor_count> combined =
+      combine();
+
+  constexpr static std::size_t count_terms() {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < factor_count; ++i) {
+      count += combined[i].base_id == i;
+    }
+    return count;
+  }
+
+  constexpr static std::size_t term_count = count_terms();
+
+  /// True if entry \p i of `combined` is a rational term with a non-zero
+  /// exponent.
+  constexpr static bool is_rational_term(std::size_t i) {
+    const auto &f = combined[i];
+    return f.base_id == i && !f.is_dimensional && f.is_rational_value &&
+           !f.exponent.is_zero();
+  }
+
+  constexpr static std::size_t count_rational_terms() {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < factor_count; ++i) {
+      count += is_rational_term(i);
+    }
+    return count;
+  }
+
+  /// Bounds the number of prime factors before they are combined.
+  constexpr static std::size_t prime_capacity =
+      count_rational_terms() * MAX_PRIME_FACTORS_PER_RATIO;
+
+  /// Prime-factorizes the rational terms with non-zero exponents. Each term
+  /// reuses the shared factorization of its value, raised to its exponent.
+  constexpr static static_vector<prime_factor, prime_capacity> factorize() {
+    static_vector<prime_factor, prime_capacity> primes;
+    for (std::size_t i = 0; i < factor_count; ++i) {
+      if (is_rational_term(i)) {
+        for (const auto &p : *combined[i].rational_primes) {
+          primes.emplace_back(p.base, p.exponent * combined[i].exponent);
+        }
+      }
+    }
+    combine_prime_factors(primes);
+    return primes;
+  }
+
+  constexpr static static_vector<prime_factor, prime_capacity> factorized =
+      factorize();
+
+public:
+  /// Type of the signature of `Units`.
+  using signature_type = units_signature<term_count, factorized.size()>;
+
+  /// Computes the signature of `Units`.
+  constexpr static signature_type make() {
+    signature_type signature;
+    std::copy(factorized.begin(), factorized.end(), signature.primes.begin());
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < factor_count; ++i) {
+      if (combined[i].base_id == i) {
+        signature.hash_order[size] = size;
+        signature.terms[size++] = combined[i];
+      }
+    }
+    std::sort(signature.hash_order.begin(), signature.hash_order.end(),
+              [&](std::size_t lhs, std::size_t rhs) {
+                const auto &l = signature.terms[lhs];
+                const auto &r = signature.terms[rhs];
+                return l.base_hash < r.base_hash ||
+                       (l.base_hash == r.base_hash && lhs < rhs);
+              });
+    return signature;
+  }
+};
+
+/// The pre-computed signature of a unit expression.
+///
+/// \tparam Units The unit expression.
+///
+template <units Units>
+constexpr typename units_signature_builder<Units>::signature_type
+    units_signature_object = units_signature_builder<Units>::make();
+
+} // namespace mu::detail
+
+#endif
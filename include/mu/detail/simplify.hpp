@@ -0,0 +1,253 @@
+#ifndef INCLUDED_MU_DETAIL_SIMPLIFY_HPP
+#define INCLUDED_MU_DETAIL_SIMPLIFY_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mu/detail/ratio.hpp>
+#include <mu/detail/std_ratio.hpp>
+#include <mu/detail/symbols.hpp>
+#include <mu/detail/type_key.hpp>
+#include <mu/detail/units_concept.hpp>
+#include <mu/npow.hpp>
+#include <mu/pow.hpp>
+#include <ratio>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// \file simplify.hpp
+///
+/// This file computes the simplified display form of unit expressions, which
+/// is used when `format_options::simplified` is set.
+
+namespace mu::detail {
+
+/// One term of a flattened unit expression: an atom raised to a rational
+/// power.
+///
+/// Atoms are the units that are displayed as a whole: named units, named
+/// constants and `std::ratio` values. A prefix followed by another unit in the
+/// same `mult` (e.g. `mult<kilo, meter>`) is also a single atom, so the prefix
+/// stays attached to its unit.
+///
+/// \tparam Atom The units displayed by this term.
+/// \tparam ExpNum Numerator of the exponent.
+/// \tparam ExpDen Denominator of the exponent.
+///
+template <class Atom, std::intmax_t ExpNum, std::intmax_t ExpDen>
+struct display_term {};
+
+/// Concept is `true` for named units that attach to the following unit.
+template <class T>
+concept prefix_unit = has_prefix<T> && T::is_prefix;
+
+/// Flattens a unit expression into a `mult` of `display_term` types. By
+/// default, the expression is a single atom.
+///
+/// \tparam Units The unit expression.
+///
+template <class Units> struct display_terms {
+  using type = mult<display_term<Units, 1, 1>>;
+};
+
+template <class Units>
+using display_terms_t = typename display_terms<Units>::type;
+
+/// Groups each prefix in a list of units with the unit that follows it.
+///
+/// \tparam Grouped A `mult` of the units grouped so far.
+/// \tparam Rest The units not grouped yet.
+///
+template <class Grouped, class... Rest> struct group_prefixes {
+  using type = Grouped;
+};
+
+template <class... Grouped, class Head, class... Rest>
+struct group_prefixes<mult<Grouped...>, Head, Rest...> {
+  using type = typename group_prefixes<mult<Grouped..., Head>, Rest...>::type;
+};
+
+template <class... Grouped, prefix_unit Prefix, class Next, class... Rest>
+struct group_prefixes<mult<Grouped...>, Prefix, Next, Rest...> {
+  using type = typename group_prefixes<mult<Grouped..., mult<Prefix, Next>>,
+                                       Rest...>::type;
+};
+
+/// Flattens every grouped unit of a product.
+template <class Grouped> struct display_terms_of_group {};
+
+template <class... Grouped> struct display_terms_of_group<mult<Grouped...>> {
+  using type = mult_concat_t<mult<>, display_terms_t<Grouped>...>;
+};
+
+/// A product flattens to the terms of its units. A prefix and the unit that
+/// follows it are one atom.
+template <class... Units> struct display_terms<mult<Units...>> {
+  using type = typename display_terms_of_group<
+      typename group_prefixes<mult<>, Units...>::type>::type;
+};
+
+/// A product that is only a prefix and its unit is one atom.
+template <prefix_unit Prefix, class Next>
+struct display_terms<mult<Prefix, Next>> {
+  using type = mult<display_term<mult<Prefix, Next>, 1, 1>>;
+};
+
+/// Raises every term to a power, simplifying the exponents.
+template <class Terms, std::intmax_t ExpNum, std::intmax_t ExpDen>
+struct pow_display_terms {};
+
+template <class... Atoms, std::intmax_t... Nums, std::intmax_t... Dens,
+          std::intmax_t ExpNum, std::intmax_t ExpDen>
+struct pow_display_terms<mult<display_term<Atoms, Nums, Dens>...>, ExpNum,
+                         ExpDen> {
+  template <std::intmax_t Num, std::intmax_t Den>
+  using term_exponent = std::ratio_multiply<std::ratio<Num, Den>,
+                                            std::ratio<ExpNum, ExpDen>>;
+
+  using type = mult<display_term<Atoms, term_exponent<Nums, Dens>::num,
+                                 term_exponent<Nums, Dens>::den>...>;
+};
+
+/// A power flattens to the terms of its base, each raised to the power.
+template <class Base, std::intmax_t ExpNum, std::intmax_t ExpDen>
+struct display_terms<pow<Base, ExpNum, ExpDen>> {
+  using type =
+      typename pow_display_terms<display_terms_t<Base>, ExpNum, ExpDen>::type;
+};
+
+/// An `npow` flattens to its base value raised to its exponent, so that
+/// `npow` terms with the same base are combined.
+template <std::intmax_t BaseValue, std::intmax_t Exponent>
+struct display_terms<npow<BaseValue, Exponent>> {
+  using type = mult<display_term<std::ratio<BaseValue>, Exponent, 1>>;
+};
+
+/// How `combine_display_terms` orders the combined terms.
+enum class display_term_order {
+  /// Terms with positive exponents come before terms with negative exponents.
+  /// Otherwise, terms keep the order in which their atoms first appear.
+  positive_first,
+
+  /// Terms are sorted by the `type_key` of their atoms.
+  type_key
+};
+
+/// Combines the flattened terms of a unit expression.
+///
+/// \tparam Terms A `mult` of `display_term` types.
+/// \tparam Order How the combined terms are ordered.
+///
+template <class Terms, display_term_order Order>
+struct combine_display_terms {};
+
+template <class... Atoms, std::intmax_t... Nums, std::intmax_t... Dens,
+          display_term_order Order>
+struct combine_display_terms<mult<display_term<Atoms, Nums, Dens>...>, Order> {
+private:
+  constexpr static std::size_t term_count = sizeof...(Atoms);
+
+  /// Index of the first term whose atom is `Atom`.
+  template <class Atom> constexpr static std::size_t first_index() {
+    std::size_t index = 0;
+    ((std::is_same_v<Atom, Atoms> ? false : (++index, true)) && ...);
+    return index;
+  }
+
+  /// A combined term: the index of its atom, and its total exponent.
+  struct combined_term {
+    std::size_t atom_index = 0;
+    ratio exponent = 0;
+  };
+
+  /// The combined terms, and the number of them.
+  struct combined_terms {
+    std::array<combined_term, term_count> terms{};
+    std::size_t size = 0;
+  };
+
+  /// Sums the exponents of terms with the same atom, drops atoms whose
+  /// exponents sum to zero, and orders the rest according to `Order`.
+  constexpr static combined_terms combine() {
+    std::array<std::size_t, term_count> first_indices{
+        first_index<Atoms>()...};
+    std::array<ratio, term_count> exponents{ratio{Nums, Dens}...};
+    std::array<ratio, term_count> sums{};
+    for (std::size_t i = 0; i < term_count; ++i) {
+      sums[i] = 0;
+    }
+    for (std::size_t i = 0; i < term_count; ++i) {
+      sums[first_indices[i]] += exponents[i];
+      sums[first_indices[i]].simplify();
+    }
+    combined_terms result;
+    if constexpr (Order == display_term_order::positive_first) {
+      for (bool positive : {true, false}) {
+        for (std::size_t i = 0; i < term_count; ++i) {
+          if (first_indices[i] == i && !sums[i].is_zero() &&
+              sums[i].is_negative() != positive) {
+            result.terms[result.size++] = combined_term{i, sums[i]};
+          }
+        }
+      }
+    } else {
+      // Insertion sort by type key. Atoms are unique, so keys are too.
+      std::array<std::string_view, term_count> keys{type_key<Atoms>()...};
+      for (std::size_t i = 0; i < term_count; ++i) {
+        if (first_indices[i] != i || sums[i].is_zero()) {
+          continue;
+        }
+        std::size_t pos = result.size++;
+        for (; pos > 0 && keys[i] < keys[result.terms[pos - 1].atom_index];
+             --pos) {
+          result.terms[pos] = result.terms[pos - 1];
+        }
+        result.terms[pos] = combined_term{i, sums[i]};
+      }
+    }
+    return result;
+  }
+
+  constexpr static combined_terms combined = combine();
+
+  /// Units for a combined term. An exponent of 1 is not displayed.
+  template <std::size_t Index> struct term_units {
+    constexpr static combined_term term = combined.terms[Index];
+    using atom = std::tuple_element_t<term.atom_index, std::tuple<Atoms...>>;
+    using type =
+        std::conditional_t<term.exponent.is_identity(), atom,
+                           pow<atom, term.exponent.num, term.exponent.den>>;
+  };
+
+  template <std::size_t... Indices>
+  static auto make_units(std::index_sequence<Indices...>)
+      -> mult<typename term_units<Indices>::type...>;
+
+public:
+  using type = decltype(make_units(std::make_index_sequence<combined.size>{}));
+};
+
+/// The simplified display form of a unit expression.
+///
+/// The expression is flattened into terms, terms with the same atom are
+/// combined, terms whose exponents sum to zero are dropped, and terms with
+/// positive exponents are ordered before terms with negative exponents.
+/// Otherwise, terms keep the order in which their atoms first appear. For
+/// example, `mult<meter, per<meter>, second, per<hour>>` simplifies to
+/// `mult<second, per<hour>>`. The result is equivalent to the original
+/// expression, and is only used to format it.
+///
+/// \tparam Units The unit expression to simplify.
+///
+template <class Units> struct simplify_units {
+  using type = typename combine_display_terms<
+      display_terms_t<Units>, display_term_order::positive_first>::type;
+};
+
+template <class Units>
+using simplify_units_t = typename simplify_units<Units>::type;
+
+} // namespace mu::detail
+
+#endif
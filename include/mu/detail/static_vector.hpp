@@ -0,0 +1,107 @@
+#ifndef INCLUDED_MU_DETAIL_STATIC_VECTOR_HPP
+#define INCLUDED_MU_DETAIL_STATIC_VECTOR_HPP
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace mu::detail {
+
+/// A vector with a fixed capacity, stored inline.
+///
+/// Unlike `std::vector`, a `static_vector` never allocates, so it is cheap to
+/// use during constant evaluation and it can be stored in a constexpr
+/// variable. Elements beyond the size are default-constructed.
+///
+/// \tparam T Type of the elements. Must be default-constructible.
+/// \tparam Capacity Maximum number of elements.
+///
+template <class T, std::size_t Capacity> class static_vector {
+public:
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  constexpr static_vector() = default;
+
+  /// Number of elements.
+  constexpr std::size_t size() const { return size_; }
+
+  /// Maximum number of elements.
+  constexpr static std::size_t capacity() { return Capacity; }
+
+  /// True if there are no elements.
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr iterator begin() { return elements_.data(); }
+  constexpr iterator end() { return elements_.data() + size_; }
+  constexpr const_iterator begin() const { return elements_.data(); }
+  constexpr const_iterator end() const { return elements_.data() + size_; }
+
+  constexpr T &operator[](std::size_t index) { return elements_[index]; }
+  constexpr const T &operator[](std::size_t index) const {
+    return elements_[index];
+  }
+
+  /// Appends an element.
+  ///
+  /// \throw std::length_error if the vector is full. During constant
+  /// evaluation, this is a compile-time error.
+  ///
+  constexpr void push_back(T value) {
+    check_capacity(size_ + 1);
+    elements_[size_++] = std::move(value);
+  }
+
+  /// Appends an element constructed from \p args.
+  ///
+  /// \throw std::length_error if the vector is full.
+  ///
+  template <class... Args> constexpr T &emplace_back(Args &&...args) {
+    check_capacity(size_ + 1);
+    elements_[size_] = T(std::forward<Args>(args)...);
+    return elements_[size_++];
+  }
+
+  /// Changes the number of elements. New elements are default-constructed.
+  ///
+  /// \throw std::length_error if \p size exceeds the capacity.
+  ///
+  constexpr void resize(std::size_t size) {
+    check_capacity(size);
+    for (std::size_t i = size_; i < size; ++i) {
+      elements_[i] = T{};
+    }
+    size_ = size;
+  }
+
+  /// Removes all elements.
+  constexpr void clear() { size_ = 0; }
+
+  /// True if both vectors hold equal elements.
+  constexpr bool operator==(const static_vector &rhs) const {
+    if (size_ != rhs.size_) {
+      return false;
+    }
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (!(elements_[i] == rhs.elements_[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  constexpr static void check_capacity(std::size_t size) {
+    if (size > Capacity) {
+      throw std::length_error("mu::detail::static_vector capacity exceeded");
+    }
+  }
+
+  std::array<T, Capacity> elements_{};
+  std::size_t size_ = 0;
+};
+
+} // namespace mu::detail
+
+#endif
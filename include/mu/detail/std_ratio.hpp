@@ -3,7 +3,7 @@
 #include <mu/detail/factor.hpp>
 #include <mu/detail/ratio.hpp>
 #include <mu/detail/unit_string.hpp>
-#include <mu/units.hpp>
+#include <mu/detail/units_concept.hpp>
 #include <ratio>
 
 namespace mu::detail {
@@ -3,7 +3,7 @@
 #include <concepts>
 #include <mu/detail/factor.hpp>
 #include <mu/detail/ratio.hpp>
-#include <mu/units.hpp>
+#include <mu/detail/units_concept.hpp>
 
 /// \file symbols.hpp
 ///
@@ -0,0 +1,57 @@
+#ifndef INCLUDED_MU_DETAIL_TYPE_KEY_HPP
+#define INCLUDED_MU_DETAIL_TYPE_KEY_HPP
+#include <cstdint>
+#include <string_view>
+
+namespace mu::detail {
+
+/// Returns a string that uniquely identifies `T`, available at compile-time.
+///
+/// The key is the compiler's pretty-printed signature of this function, so it
+/// is only stable for a given compiler and version. It is suitable for sorting
+/// types into a canonical order within a program, but it must not be stored or
+/// compared across builds.
+///
+/// \tparam T The type to identify.
+///
+template <class T> constexpr std::string_view type_key() {
+#if defined(__clang__) || defined(__GNUC__)
+  return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+  return __FUNCSIG__;
+#else
+#error "mu::detail::type_key is not supported by this compiler"
+#endif
+}
+
+/// Hash of `type_key<T>()`, computed once per type in each translation unit.
+///
+/// Distinct types may have the same hash. Use `type_id` to tell them apart.
+///
+/// \tparam T The type to hash.
+///
+template <class T>
+constexpr std::uint64_t type_hash = [] {
+  // 64-bit FNV-1a.
+  std::uint64_t hash = 14695981039346656037ull;
+  for (char c : type_key<T>()) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return hash;
+}();
+
+/// Holds an object whose address is unique to `T`.
+template <class T> struct type_id_holder {
+  constexpr static char value = 0;
+};
+
+/// Address that uniquely identifies `T`. Two ids can be compared for equality
+/// at compile-time, but they have no order.
+///
+/// \tparam T The type to identify.
+///
+template <class T> constexpr const void *type_id = &type_id_holder<T>::value;
+
+} // namespace mu::detail
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef INCLUDED_MU_DETAIL_UNIT_LABEL_HPP
+#define INCLUDED_MU_DETAIL_UNIT_LABEL_HPP
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <mu/detail/simplify.hpp>
+#include <mu/format_options.hpp>
+#include <mu/units.hpp>
+#include <string_view>
+#include <utility>
+
+namespace mu::detail {
+
+/// Character that stands in for `format_options::mult_sep` in precomputed
+/// labels.
+///
+/// The separator is a runtime string, so it cannot be baked into a label at
+/// compile-time. Instead, labels are rendered with this placeholder (the ASCII
+/// "unit separator" control character, which never appears in printable unit
+/// names), and the real separator is substituted when the label is written.
+///
+constexpr char MULT_SEP_PLACEHOLDER = '\x1f';
+
+/// Number of entries in a `unit_label_table`.
+constexpr std::size_t UNIT_LABEL_TABLE_SIZE = 8;
+
+/// Returns the index of the `unit_label_table` entry that matches the
+/// compile-time relevant parts of \p opts. The `mult_sep` option does not
+/// affect the index.
+///
+constexpr std::size_t unit_label_index(const format_options &opts) {
+  std::size_t index = 0;
+  if (opts.labels == format_options::label_type::symbols) {
+    index |= 1;
+  }
+  if (opts.superscript_exponents) {
+    index |= 2;
+  }
+  if (opts.simplified) {
+    index |= 4;
+  }
+  return index;
+}
+
+/// Returns the options that correspond to a `unit_label_table` index. The
+/// `mult_sep` of the result is \p mult_sep.
+///
+constexpr format_options unit_label_options(std::size_t index,
+                                            const char *mult_sep) {
+  format_options opts;
+  opts.labels = (index & 1) ? format_options::label_type::symbols
+                            : format_options::label_type::names;
+  opts.superscript_exponents = (index & 2) != 0;
+  opts.simplified = (index & 4) != 0;
+  opts.mult_sep = mult_sep;
+  return opts;
+}
+
+/// A label rendered at compile-time.
+struct unit_label {
+  /// The label, where each mult separator is a `MULT_SEP_PLACEHOLDER`.
+  std::string_view value;
+
+  /// The label, where each mult separator is the default `mult_sep`.
+  std::string_view default_value;
+
+  /// True if the label contains at least one mult separator.
+  bool has_mult_sep = false;
+};
+
+/// Holds the label of `Units` for every combination of `label_type`,
+/// `superscript_exponents` and `simplified`. Each label is rendered once, at
+/// compile-time, into a static character array.
+///
+/// \tparam Units Render labels for these units.
+///
+template <units Units> class unit_label_table {
+private:
+  /// Length of the label for table entry \p index, using \p mult_sep.
+  constexpr static std::size_t length(std::size_t index,
+                                      const char *mult_sep) {
+    return unit_string_size<Units>(unit_label_options(index, mult_sep));
+  }
+
+  /// Renders the label for table entry `Index` into a character array.
+  template <std::size_t Index, std::size_t Length>
+  constexpr static std::array<char, Length> render(const char *mult_sep) {
+    static_unit_string<Length, unit_string_depth_v<Units>> ustr{
+        unit_label_options(Index, mult_sep)};
+    format_units<Units>(ustr);
+    std::array<char, Length> chars{};
+    std::copy_n(ustr.str().data(), Length, chars.data());
+    return chars;
+  }
+
+  constexpr static const char PLACEHOLDER_SEP[] = {MULT_SEP_PLACEHOLDER, '\0'};
+  constexpr static const char *DEFAULT_SEP = format_options{}.mult_sep;
+
+  template <std::size_t Index>
+  constexpr static auto placeholder_chars =
+      render<Index, length(Index, PLACEHOLDER_SEP)>(PLACEHOLDER_SEP);
+
+  template <std::size_t Index>
+  constexpr static auto default_chars =
+      render<Index, length(Index, DEFAULT_SEP)>(DEFAULT_SEP);
+
+  template <std::size_t Index> constexpr static unit_label make_label() {
+    unit_label label;
+    label.value = {placeholder_chars<Index>.data(),
+                   placeholder_chars<Index>.size()};
+    label.default_value = {default_chars<Index>.data(),
+                           default_chars<Index>.size()};
+    label.has_mult_sep =
+        label.value.find(MULT_SEP_PLACEHOLDER) != std::string_view::npos;
+    return label;
+  }
+
+  template <std::size_t... Indices>
+  constexpr static std::array<unit_label, UNIT_LABEL_TABLE_SIZE>
+  make_labels(std::index_sequence<Indices...>) {
+    return {make_label<Indices>()...};
+  }
+
+public:
+  /// The precomputed labels, indexed by `unit_label_index`.
+  constexpr static std::array<unit_label, UNIT_LABEL_TABLE_SIZE> labels =
+      make_labels(std::make_index_sequence<UNIT_LABEL_TABLE_SIZE>{});
+
+  /// Gets the precomputed label that matches \p opts.
+  constexpr static const unit_label &get(const format_options &opts) {
+    return labels[unit_label_index(opts)];
+  }
+};
+
+/// Writes a precomputed label, substituting \p mult_sep for each
+/// `MULT_SEP_PLACEHOLDER`.
+///
+/// \param label The precomputed label.
+/// \param mult_sep The separator to substitute.
+/// \param write Callable invoked as `write(const char *, std::size_t)` for each
+/// contiguous piece of output. If the label needs no substitution, it is
+/// invoked exactly once.
+///
+template <class Writer>
+constexpr void write_unit_label(const unit_label &label,
+                                std::string_view mult_sep, Writer &&write) {
+  if (!label.has_mult_sep) {
+    write(label.value.data(), label.value.size());
+    return;
+  }
+  if (mult_sep == std::string_view{format_options{}.mult_sep}) {
+    write(label.default_value.data(), label.default_value.size());
+    return;
+  }
+  std::string_view rest = label.value;
+  for (auto pos = rest.find(MULT_SEP_PLACEHOLDER);
+       pos != std::string_view::npos; pos = rest.find(MULT_SEP_PLACEHOLDER)) {
+    write(rest.data(), pos);
+    write(mult_sep.data(), mult_sep.size());
+    rest.remove_prefix(pos + 1);
+  }
+  write(rest.data(), rest.size());
+}
+
+/// Matches a precomputed label against the beginning of \p input, where each
+/// `MULT_SEP_PLACEHOLDER` must match \p mult_sep.
+///
+/// \param label The precomputed label.
+/// \param mult_sep The separator expected in place of each placeholder.
+/// \param input The text to match.
+/// \return The number of characters of \p input that matched the label, or 0 if
+/// \p input does not begin with the label.
+///
+constexpr std::size_t match_unit_label(const unit_label &label,
+                                       std::string_view mult_sep,
+                                       std::string_view input) {
+  std::size_t matched = 0;
+  std::string_view rest = label.value;
+  while (true) {
+    auto pos = rest.find(MULT_SEP_PLACEHOLDER);
+    std::string_view piece = rest.substr(0, pos);
+    if (input.substr(matched, piece.size()) != piece) {
+      return 0;
+    }
+    matched += piece.size();
+    if (pos == std::string_view::npos) {
+      return matched;
+    }
+    if (input.substr(matched, mult_sep.size()) != mult_sep) {
+      return 0;
+    }
+    matched += mult_sep.size();
+    rest.remove_prefix(pos + 1);
+  }
+}
+
+} // namespace mu::detail
+
+#endif
@@ -1,10 +1,15 @@
 #ifndef INCLUDED_MU_DETAIL_UNIT_STRING_HPP
 #define INCLUDED_MU_DETAIL_UNIT_STRING_HPP
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <mu/detail/ratio.hpp>
 #include <mu/format_options.hpp>
-#include <string>
-#include <vector>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 
 namespace mu::detail {
 
@@ -26,22 +31,91 @@ struct labels {
 /// how the units are formatted, and passed down the expression tree to each
 /// unit, which can add itself to the string by calling various methods on it.
 ///
+/// The string is written into a caller-provided buffer, and the `unit_string`
+/// itself never allocates, so it can be used both in constant evaluation and in
+/// code that must not touch the heap. Like `snprintf`, output that does not fit
+/// the buffer is dropped, but `size` still counts it. Formatting once without a
+/// buffer therefore measures the exact capacity needed to format again without
+/// truncation. The stack of nested subexpressions is also caller-provided, and
+/// `unit_string_depth_v` gives the depth a unit expression needs. See
+/// `static_unit_string` for a `unit_string` that owns its buffer and stack.
+///
+/// Separators are written as soon as a subexpression is pushed, and a
+/// subexpression raised to a power is enclosed in parentheses by shifting it
+/// right in place, so formatting is linear in the length of the result for
+/// all but deeply nested powers.
+///
 class unit_string {
 public:
-  /// Construct a `unit_string` with a set of formatting options.
+  /// An entry of the stack of subexpressions.
+  struct subexpression {
+    /// Offset of the subexpression in the formatted string.
+    std::size_t start = 0;
+
+    /// True if the subexpression ends with a named prefix. An immediately
+    /// following named unit must not use a mult separator.
+    bool ends_with_prefix = false;
+
+    /// True if the subexpression contains a mult separator. If so, raising the
+    /// entire subexpression to a power would require enclosing the
+    /// subexpression in parentheses.
+    bool pow_requires_parens = false;
+  };
+
+  /// Construct a `unit_string` without a buffer. It only measures the length
+  /// of the formatted unit expression.
   ///
   /// \see format_options which describe all the ways formatting can be
   /// customized.
   ///
-  constexpr unit_string(format_options opts)
-      : opts_{std::move(opts)}, subexpression_stack_{1} {}
+  /// \param opts Describe how the units are formatted.
+  /// \param stack Storage for the stack of subexpressions. It must hold one
+  /// more entry than the number of nested subexpressions (see
+  /// `unit_string_stack`).
+  ///
+  constexpr unit_string(format_options opts, std::span<subexpression> stack)
+      : unit_string{std::move(opts), stack, nullptr, 0} {}
+
+  /// Construct a `unit_string` that writes into a buffer.
+  ///
+  /// \param opts Describe how the units are formatted.
+  /// \param stack Storage for the stack of subexpressions. It must hold one
+  /// more entry than the number of nested subexpressions (see
+  /// `unit_string_stack`).
+  /// \param buffer Destination of the formatted string. It is not
+  /// null-terminated.
+  /// \param capacity Size of \p buffer.
+  ///
+  constexpr unit_string(format_options opts, std::span<subexpression> stack,
+                        char *buffer, std::size_t capacity)
+      : opts_{std::move(opts)}, mult_sep_{opts_.mult_sep}, buffer_{buffer},
+        capacity_{buffer ? capacity : 0}, subexpression_stack_{stack} {
+    subexpression_stack_.front() = subexpression{};
+  }
+
+  /// Copying would alias the buffer.
+  unit_string(const unit_string &) = delete;
+  unit_string &operator=(const unit_string &) = delete;
 
   /// Push a new subexpression into scope.
   ///
   /// Until the next call to `pop`, methods called on the `unit_string` pertain
   /// only to the current subexpression.
   ///
-  constexpr void push() { subexpression_stack_.emplace_back(); }
+  /// \throw std::length_error if the stack has no room for another
+  /// subexpression. In constant evaluation, this is a compile-time error.
+  ///
+  constexpr void push() {
+    if (depth_ == subexpression_stack_.size()) {
+      throw std::length_error("mu::detail::unit_string stack is too small");
+    }
+    subexpression &parent = back();
+    if (size_ != parent.start && !parent.ends_with_prefix) {
+      append(mult_sep_);
+      parent.pow_requires_parens = true;
+    }
+    subexpression_stack_[depth_++] = subexpression{size_};
+  }
 
   /// End the current subexpression.
   ///
@@ -49,13 +123,7 @@ public:
   /// *especially* must NOT call `pop` more times than they call `push`.
   ///
   constexpr void pop() {
-    subexpression top = std::move(back());
-    subexpression_stack_.pop_back();
-    if (!back().str.empty() && !back().ends_with_prefix) {
-      back().str += opts_.mult_sep;
-      back().pow_requires_parens = true;
-    }
-    back().str += top.str;
+    subexpression top = subexpression_stack_[--depth_];
     back().ends_with_prefix = top.ends_with_prefix;
     back().pow_requires_parens =
         back().pow_requires_parens || top.pow_requires_parens;
@@ -64,19 +132,19 @@ public:
   /// Multiply the current subexpression by a named unit or constant.
   ///
   constexpr void multiply(const labels &named_unit) {
-    if (!back().str.empty() && !back().ends_with_prefix) {
-      back().str += opts_.mult_sep;
+    if (size_ != back().start && !back().ends_with_prefix) {
+      append(mult_sep_);
       back().pow_requires_parens = true;
     }
     switch (opts_.labels) {
     case format_options::label_type::names:
-      back().str += named_unit.name;
+      append(named_unit.name);
       break;
     case format_options::label_type::symbols:
-      back().str += named_unit.symbol;
+      append(named_unit.symbol);
       break;
     default:
-      back().str += named_unit.name;
+      append(named_unit.name);
     }
     back().ends_with_prefix = named_unit.is_prefix;
   }
@@ -84,102 +152,124 @@ public:
   /// Multiply the current subexpression by a rational value.
   ///
   constexpr void multiply(ratio constant_value) {
-    if (!back().str.empty()) {
-      back().str += opts_.mult_sep;
+    if (size_ != back().start) {
+      append(mult_sep_);
       back().pow_requires_parens = true;
     }
-    back().str += to_string(constant_value, false);
+    append(constant_value, false);
     back().ends_with_prefix = false;
   }
 
   /// Raise the entire current subexpression to a rational power.
   ///
   constexpr void pow(ratio exponent) {
-    std::string suffix;
-    if (opts_.superscript_exponents) {
-      suffix = to_string(exponent, true);
-    } else {
-      suffix = "^" + to_string(exponent, false);
-    }
     if (back().pow_requires_parens) {
-      back().str = "(" + back().str + ")" + suffix;
-    } else {
-      back().str += suffix;
+      insert_open_paren(back().start);
+      append(")");
     }
+    if (!opts_.superscript_exponents) {
+      append("^");
+    }
+    append(exponent, opts_.superscript_exponents);
     back().pow_requires_parens = true;
   }
 
+  /// Get the options that describe how the units are formatted.
+  ///
+  constexpr const format_options &options() const { return opts_; }
+
   /// Get the formatted unit expression resulting from all previous method
-  /// calls.
+  /// calls. If the buffer was too small, this is only the part that fit.
   ///
-  constexpr std::string str() const {
-    std::string ret;
-    for (const auto &subexpr : subexpression_stack_) {
-      ret += subexpr.str;
-    }
-    return ret;
+  constexpr std::string_view str() const {
+    return {buffer_, std::min(size_, capacity_)};
   }
 
+  /// Get the length of the formatted unit expression, including any part that
+  /// did not fit in the buffer.
+  ///
+  constexpr std::size_t size() const { return size_; }
+
 private:
   /// Describe cosmetic options how the units are formatted.
   format_options opts_;
 
-  /// The `unit_string` maintains a stack of subexpressions.
-  struct subexpression {
-    /// Formatted subexpression.
-    std::string str;
+  /// The mult separator from `opts_`.
+  std::string_view mult_sep_;
 
-    /// True if the subexpression ends with a named prefix. An immediately
-    /// following named unit must not use a mult separator.
-    bool ends_with_prefix = false;
+  /// Destination of the formatted string, or `nullptr` when measuring.
+  char *buffer_;
 
-    /// True if the subexpression contains a mult separator. If so, raising the
-    /// entire subexpression to a power would require enclosing the
-    /// subexpression in parentheses.
-    bool pow_requires_parens = false;
-  };
-  std::vector<subexpression> subexpression_stack_;
+  /// Size of `buffer_`.
+  std::size_t capacity_;
+
+  /// Length of the formatted string, including characters that did not fit.
+  std::size_t size_ = 0;
+
+  /// The `unit_string` maintains a stack of subexpressions.
+  std::span<subexpression> subexpression_stack_;
+
+  /// Number of subexpressions on the stack. The bottom one is never popped.
+  std::size_t depth_ = 1;
 
 private:
   /// Gets the top of the subexpression stack.
-  constexpr subexpression &back() { return subexpression_stack_.back(); }
+  constexpr subexpression &back() { return subexpression_stack_[depth_ - 1]; }
 
-  /// Formats the integer as a string. Note `std::to_string` is not sufficient
-  /// because it is not constexpr. If \p superscript is `true`, format digits
-  /// using their superscript versions (assume UTF-8).
+  /// Appends text to the formatted string.
+  constexpr void append(std::string_view text) {
+    if (size_ < capacity_) {
+      std::size_t count = std::min(text.size(), capacity_ - size_);
+      std::copy_n(text.data(), count, buffer_ + size_);
+    }
+    size_ += text.size();
+  }
+
+  /// Inserts `(` at offset \p pos, shifting the rest of the formatted string
+  /// one character to the right.
+  constexpr void insert_open_paren(std::size_t pos) {
+    ++size_;
+    if (pos < capacity_) {
+      std::size_t end = std::min(size_, capacity_);
+      std::copy_backward(buffer_ + pos, buffer_ + end - 1, buffer_ + end);
+      buffer_[pos] = '(';
+    }
+  }
+
+  /// Appends the integer. Note `std::to_chars` is not sufficient because it is
+  /// not constexpr. If \p superscript is `true`, format digits using their
+  /// superscript versions (assume UTF-8).
   ///
-  constexpr static std::string to_string(std::intmax_t value,
-                                         bool superscript) {
-    std::string ret;
+  constexpr void append(std::intmax_t value, bool superscript) {
     bool negative = (value < 0);
     if (negative) {
       value *= -1;
-    };
+      append(superscript ? "⁻" : "-");
+    }
+    int digits[std::numeric_limits<std::intmax_t>::digits10 + 1] = {};
+    int count = 0;
     while (value > 0) {
-      prepend_digit(ret, value % 10, superscript);
+      digits[count++] = static_cast<int>(value % 10);
       value /= 10;
-    };
-    if (negative) {
-      ret.insert(0, superscript ? "⁻" : "-");
     }
-    return ret;
+    while (count > 0) {
+      append_digit(digits[--count], superscript);
+    }
   }
 
-  /// Formats a ratio as a string. If the denominator of the ratio is 1, then
-  /// this only formats the numerator. If \p superscript is `true`, format
-  /// digits using their superscript versions (assume UTF-8).
+  /// Appends a ratio. If the denominator of the ratio is 1, then this only
+  /// appends the numerator. If \p superscript is `true`, format digits using
+  /// their superscript versions (assume UTF-8).
   ///
-  constexpr static std::string to_string(ratio value, bool superscript) {
-    if (value.den == 1) {
-      return to_string(value.num, superscript);
-    } else {
-      return to_string(value.num, superscript) + (superscript ? "ᐟ" : "/") +
-             to_string(value.den, superscript);
+  constexpr void append(ratio value, bool superscript) {
+    append(value.num, superscript);
+    if (value.den != 1) {
+      append(superscript ? "ᐟ" : "/");
+      append(value.den, superscript);
     }
   }
 
-  constexpr static void prepend_digit(std::string &out, int digit,
-                                      bool superscript) {
+  constexpr void append_digit(int digit, bool superscript) {
     if (superscript) {
       const char *glyph;
       switch (digit) {
@@ -197,14 +287,54 @@ private:
       default: glyph = "ᵡ"; break;
         // clang-format on
       }
-      out.insert(0, glyph);
+      append(glyph);
 
     } else {
-      out.insert(0, 1, static_cast<char>('0' + digit));
+      char ch = static_cast<char>('0' + digit);
+      append(std::string_view{&ch, 1});
     }
   }
 };
 
+/// Storage for the stack of a `unit_string` that nests up to `Depth`
+/// subexpressions.
+template <std::size_t Depth>
+using unit_string_stack = std::array<unit_string::subexpression, Depth + 1>;
+
+/// Holds the buffer and the stack of a `static_unit_string`. It is a separate
+/// base class so that they are constructed before the `unit_string` base that
+/// refers to them.
+///
+template <std::size_t Capacity, std::size_t Depth>
+struct static_unit_string_storage {
+  std::array<char, Capacity> buffer{};
+  unit_string_stack<Depth> stack{};
+};
+
+/// A `unit_string` that owns a fixed-capacity buffer and stack.
+///
+/// To format a unit expression without truncation, first measure it with a
+/// `unit_string` that has no buffer. For example:
+///
+///   ```
+///   constexpr std::size_t size = unit_string_size<Units>(opts);
+///   static_unit_string<size, unit_string_depth_v<Units>> ustr{opts};
+///   format_units<Units>(ustr);
+///   ```
+///
+/// \tparam Capacity Size of the buffer.
+/// \tparam Depth Number of subexpressions that can be nested.
+///
+template <std::size_t Capacity, std::size_t Depth>
+class static_unit_string : private static_unit_string_storage<Capacity, Depth>,
+                           public unit_string {
+public:
+  constexpr explicit static_unit_string(format_options opts)
+      : static_unit_string_storage<Capacity, Depth>{},
+        unit_string{std::move(opts), this->stack, this->buffer.data(),
+                    Capacity} {}
+};
+
 } // namespace mu::detail
 
 #endif
\ No newline at end of file
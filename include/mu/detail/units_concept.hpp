@@ -0,0 +1,146 @@
+#ifndef INCLUDED_MU_DETAIL_UNITS_CONCEPT_HPP
+#define INCLUDED_MU_DETAIL_UNITS_CONCEPT_HPP
+#include <mu/detail/factor.hpp>
+#include <mu/detail/unit_string.hpp>
+#include <mu/format_options.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+/// \file units_concept.hpp
+///
+/// This file defines the `units` concept and product expressions, without the
+/// functions that format units. Headers that define units, and the headers
+/// used to format them, include this file, so that `mu/units.hpp` can include
+/// all of them. Other code should include `mu/units.hpp` instead.
+
+namespace mu {
+
+/// Represents a product of unit expressions.
+///
+/// \tparam ...Ts Each type in the list must conform to the units concept. If
+/// this type list is empty, this represents the multiplicative identity (i.e.
+/// `1`)
+///
+template <class... Ts> using mult = std::tuple<Ts...>;
+
+namespace detail {
+
+/// Concatenates several product expressions into a single product expression.
+///
+/// \tparam ...Mults Each type in the list must be a specialization of mult<>.
+///
+template <class... Mults>
+using mult_concat_t = decltype(std::tuple_cat(std::declval<Mults>()...));
+
+/// Contains a static bool member called `value` that is `true` when T is a
+/// specialization of mult, and each type in the mult matches the `factor`
+/// concept.
+///
+/// \tparam T This must be a specialization of mult.
+/// \see mu::detail::factor
+///
+template <class T> struct is_factor_list : public std::false_type {};
+
+template <factor... Factors>
+struct is_factor_list<mult<Factors...>> : public std::true_type {};
+
+/// Defines the characteristics of types that represent units.
+///
+/// To specialize this template such that T matches the units concept, see \ref
+/// mu::units.
+///
+/// \tparam T Define units characteristics for this type.
+///
+template <class T> struct unit_traits {};
+
+} // namespace detail
+
+/// The units concept matches types that can represent units of dimensional
+/// analysis.
+///
+/// The following types match the units concept:
+///  1. Named unit types (e.g. meters, kilograms, etc.)
+///  2. Named constant types that define approximate values (e.g. pi)
+///  3. `std::ratio` types
+///  4. `mu::mult<...>` specializations, where each type in the `mult`
+///     specialization also matches the units concept.
+///  5. `mu::pow<...>` specializations, where the base type of the `pow` also
+///     matches the units concept.
+///
+template <class T>
+concept units = requires(format_options fopts, detail::unit_string &ustr) {
+  // Each units type must provide a factorization.
+  typename detail::unit_traits<T>::factors;
+
+  // The type of the above factorization must be a mult<> of types matching the
+  // `factor` concept.
+  requires detail::is_factor_list<
+      typename detail::unit_traits<T>::factors>::value;
+
+  // Each units type must provide a static `format` member that appends its
+  // string representation to a `unit_string`. Note the `format` method should
+  // take the `unit_string` as an in-out parameter, but C++ concepts can not
+  // enforce the reference-ness of the parameter.
+  { detail::unit_traits<T>::format(ustr) } -> std::same_as<void>;
+};
+
+namespace detail {
+
+/// Number of subexpressions that `unit_traits<Units>::format` nests on a
+/// `unit_string`. Unit expressions that push subexpressions define it as a
+/// static `nesting_depth` member of their `unit_traits`; other units nest none.
+///
+/// \tparam Units Count the subexpressions nested by these units.
+///
+template <units Units>
+constexpr std::size_t nesting_depth_v = [] {
+  if constexpr (requires { unit_traits<Units>::nesting_depth; }) {
+    return std::size_t{unit_traits<Units>::nesting_depth};
+  } else {
+    return std::size_t{0};
+  }
+}();
+
+/// Unit traits for an empty product expression (i.e. `1`).
+template <> struct unit_traits<mult<>> {
+
+  /// Empty product has no factors.
+  using factors = mult<>;
+
+  /// Does not modify the `unit_string`.
+  constexpr static void format(unit_string &) {}
+};
+
+/// Unit traits for a non-empty product expression.
+///
+/// \tparam UnitsHead The first unit of the product.
+/// \tparam ...UnitsTail The remaining units of the product.
+///
+template <units UnitsHead, units... UnitsTail>
+struct unit_traits<mult<UnitsHead, UnitsTail...>> {
+
+  /// Factors of a product expression are the concatenation of all
+  /// factorizations of each unit in the product expression.
+  using factors = mult_concat_t<typename unit_traits<UnitsHead>::factors,
+                                typename unit_traits<UnitsTail>::factors...>;
+
+  /// The product is one subexpression around the deepest of its terms.
+  constexpr static std::size_t nesting_depth =
+      1 + std::max({nesting_depth_v<UnitsHead>, nesting_depth_v<UnitsTail>...});
+
+  /// Creates a new subexpression consisting of every term in the product.
+  constexpr static void format(unit_string &ustr) {
+    ustr.push();
+    unit_traits<UnitsHead>::format(ustr);
+    (unit_traits<UnitsTail>::format(ustr), ...);
+    ustr.pop();
+  }
+};
+
+} // namespace detail
+
+} // namespace mu
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef INCLUDED_MU_EXECUTION_HPP
+#define INCLUDED_MU_EXECUTION_HPP
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <mu/convert.hpp>
+#include <mu/quantity.hpp>
+#include <mu/reduce.hpp>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Overloads of the bulk and reduction algorithms that take a standard execution
+// policy.
+//
+// This header is not included by `mu/mu.hpp`, because parallel policies may
+// require linking a backend of the standard library, such as TBB for
+// libstdc++.
+
+namespace mu {
+
+/// Overload of `convert` that runs according to an execution policy. With
+/// `std::execution::par` or `std::execution::par_unseq`, large buffers may be
+/// split across threads by the standard library.
+///
+/// \param policy The execution policy.
+/// \param from The quantities to convert.
+/// \param to Destination of the converted quantities. Must be at least as large
+/// as \p from.
+/// \return The part of \p to that the converted quantities were written to.
+/// \throw std::length_error if \p to is smaller than \p from.
+///
+template <class ExecutionPolicy, class FromRange, class ToRange>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::quantity_range_convertible_to<FromRange, ToRange>
+std::span<detail::range_quantity_t<ToRange>>
+convert(ExecutionPolicy &&policy, const FromRange &from, ToRange &&to) {
+  using from_quantity = detail::range_quantity_t<FromRange>;
+  using to_quantity = detail::range_quantity_t<ToRange>;
+  const std::span<const from_quantity> in{from};
+  const std::span<to_quantity> out =
+      detail::conversion_output(in, std::span<to_quantity>{to});
+  std::transform(std::forward<ExecutionPolicy>(policy), in.begin(), in.end(),
+                 out.begin(),
+                 detail::rep_converter<from_quantity, to_quantity>{});
+  return out;
+}
+
+namespace detail {
+
+/// Number of values reduced by each task of a parallel reduction.
+constexpr std::size_t reduce_chunk_size = 1 << 15;
+
+/// Splits \p count values into chunks of `reduce_chunk_size`, computes
+/// `partial(first, count)` of every chunk according to \p policy, and returns
+/// `combine(partials)` of the span of partial results. The chunks do not depend
+/// on the policy, so every policy returns the same result.
+///
+template <class T, class ExecutionPolicy, class Partial, class Combine>
+T reduce_chunks(ExecutionPolicy &&policy, std::size_t count,
+                const Partial &partial, const Combine &combine) {
+  if (count <= reduce_chunk_size) {
+    return partial(0, count);
+  }
+  std::vector<T> partials((count + reduce_chunk_size - 1) / reduce_chunk_size);
+  std::for_each(std::forward<ExecutionPolicy>(policy), partials.begin(),
+                partials.end(), [&](T &result) {
+                  const std::size_t first = static_cast<std::size_t>(
+                                                &result - partials.data()) *
+                                            reduce_chunk_size;
+                  result = partial(first,
+                                   std::min(reduce_chunk_size, count - first));
+                });
+  return combine(std::span<const T>{partials});
+}
+
+/// Adds \p count values returned by \p load according to \p policy.
+template <class T, summation Summation, class ExecutionPolicy, class Load>
+T parallel_sum_values(ExecutionPolicy &&policy, std::size_t count,
+                      const Load &load) {
+  return reduce_chunks<T>(
+      std::forward<ExecutionPolicy>(policy), count,
+      [&](std::size_t first, std::size_t n) {
+        return sum_values<T, Summation>(first, n, load);
+      },
+      [](std::span<const T> partials) {
+        return sum_values<T, Summation>(
+            0, partials.size(), [&](std::size_t i) { return partials[i]; });
+      });
+}
+
+/// Finds the extremum of \p count values returned by \p load according to
+/// \p policy. \p count must not be zero.
+template <class T, class Less, class ExecutionPolicy, class Load>
+T parallel_extremum_values(ExecutionPolicy &&policy, std::size_t count,
+                           const Load &load) {
+  return reduce_chunks<T>(
+      std::forward<ExecutionPolicy>(policy), count,
+      [&](std::size_t first, std::size_t n) {
+        return extremum_values<T, Less>(first, n, load);
+      },
+      [](std::span<const T> partials) {
+        return extremum_values<T, Less>(
+            0, partials.size(), [&](std::size_t i) { return partials[i]; });
+      });
+}
+
+} // namespace detail
+
+namespace reduce {
+
+/// Overload of `sum` that runs according to an execution policy. The range is
+/// split into fixed chunks, which are summed as by `sum` and may be spread
+/// across threads. The sums of the chunks are then added in the same way, so
+/// the result does not depend on the policy.
+///
+/// \tparam Summation How to add floating-point values.
+/// \param policy The execution policy.
+/// \param range The quantities to add.
+///
+template <summation Summation = summation::pairwise, class ExecutionPolicy,
+          class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+auto sum(ExecutionPolicy &&policy, const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using sum_rep = detail::sum_rep_t<Range>;
+  const auto values = detail::quantities_of(range);
+  return quantity<sum_rep, typename quantity_type::units_type>{
+      detail::parallel_sum_values<sum_rep, Summation>(
+          std::forward<ExecutionPolicy>(policy), values.size(),
+          detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Overload of `mean` that runs according to an execution policy, as the
+/// overload of `sum` does. \p range must not be empty.
+///
+template <summation Summation = summation::pairwise, class ExecutionPolicy,
+          class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+auto mean(ExecutionPolicy &&policy, const Range &range) {
+  const auto total =
+      reduce::sum<Summation>(std::forward<ExecutionPolicy>(policy), range);
+  using result_type = std::remove_cvref_t<decltype(total)>;
+  using sum_rep = typename result_type::rep_type;
+  return result_type{total.value() /
+                     static_cast<sum_rep>(std::ranges::size(range))};
+}
+
+/// Overload of `min` that runs according to an execution policy. \p range
+/// must not be empty.
+///
+template <class ExecutionPolicy, class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+detail::range_quantity_t<Range> min(ExecutionPolicy &&policy,
+                                    const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  const auto values = detail::quantities_of(range);
+  return quantity_type{
+      detail::parallel_extremum_values<rep_type, std::less<>>(
+          std::forward<ExecutionPolicy>(policy), values.size(),
+          detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Overload of `max` that runs according to an execution policy. \p range
+/// must not be empty.
+///
+template <class ExecutionPolicy, class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+detail::range_quantity_t<Range> max(ExecutionPolicy &&policy,
+                                    const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  const auto values = detail::quantities_of(range);
+  return quantity_type{
+      detail::parallel_extremum_values<rep_type, std::greater<>>(
+          std::forward<ExecutionPolicy>(policy), values.size(),
+          detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Overload of `dot` that runs according to an execution policy, as the
+/// overload of `sum` does.
+///
+/// \throw std::length_error if the ranges have different sizes.
+///
+template <summation Summation = summation::pairwise, class ExecutionPolicy,
+          class LhsRange, class RhsRange>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<LhsRange> &&
+         detail::arithmetic_quantity_range<RhsRange>
+auto dot(ExecutionPolicy &&policy, const LhsRange &lhs, const RhsRange &rhs) {
+  using result_type = detail::product_quantity_t<LhsRange, RhsRange>;
+  const auto lhs_values = detail::quantities_of(lhs);
+  const auto rhs_values = detail::quantities_of(rhs);
+  detail::check_dot_sizes(lhs_values.size(), rhs_values.size());
+  return result_type{
+      detail::parallel_sum_values<typename result_type::rep_type, Summation>(
+          std::forward<ExecutionPolicy>(policy), lhs_values.size(),
+          detail::load_product<detail::range_quantity_t<LhsRange>,
+                               detail::range_quantity_t<RhsRange>>{
+              lhs_values.data(), rhs_values.data()})};
+}
+
+/// Overload of `sum_of_squares` that runs according to an execution policy,
+/// as the overload of `sum` does.
+///
+template <summation Summation = summation::pairwise, class ExecutionPolicy,
+          class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+auto sum_of_squares(ExecutionPolicy &&policy, const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using result_type = detail::product_quantity_t<Range, Range>;
+  const auto values = detail::quantities_of(range);
+  return result_type{
+      detail::parallel_sum_values<typename result_type::rep_type, Summation>(
+          std::forward<ExecutionPolicy>(policy), values.size(),
+          detail::load_square<quantity_type>{values.data()})};
+}
+
+/// Overload of `norm` that runs according to an execution policy, as the
+/// overload of `sum` does.
+///
+template <summation Summation = summation::pairwise, class ExecutionPolicy,
+          class Range>
+requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+         detail::arithmetic_quantity_range<Range>
+auto norm(ExecutionPolicy &&policy, const Range &range) {
+  using units_type = typename detail::range_quantity_t<Range>::units_type;
+  const auto root = std::sqrt(
+      reduce::sum_of_squares<Summation>(std::forward<ExecutionPolicy>(policy),
+                                        range)
+          .value());
+  return quantity<std::remove_const_t<decltype(root)>, units_type>{root};
+}
+
+} // namespace reduce
+
+} // namespace mu
+
+#endif
@@ -0,0 +1,511 @@
+#ifndef INCLUDED_MU_FIXED_HPP
+#define INCLUDED_MU_FIXED_HPP
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <mu/rep.hpp>
+#include <mu/rounding.hpp>
+#include <type_traits>
+
+namespace mu {
+
+/// A binary fixed-point number: an integer `Int` that counts units of
+/// `2^-FracBits`.
+///
+/// Fixed-point values are converted between units without floating-point
+/// arithmetic. Conversions by a ratio of integers are exact before rounding.
+/// Other conversions multiply by an integer that approximates the scale and
+/// shift the product back; both constants are computed at compile time. A
+/// conversion is lossless when the result has at least the integer and the
+/// fractional bits of the value, and the scale is an integer once it is
+/// multiplied by the additional fractional bits. For example, meters convert
+/// losslessly to millimeters, and to units of two meters if the destination has
+/// one more fractional bit.
+///
+/// Arithmetic does not round. Sums and differences of values of one type have
+/// that type, and overflow as integer sums do. Values of different types are
+/// first aligned to the integer bits of the wider operand and the fractional
+/// bits of the finer operand. Products have the integer and fractional bits of
+/// both operands. These results are widened when needed, and operations whose
+/// result would need more than 64 bits are not defined. Quotients have the
+/// fractional bits of the dividend, and are truncated.
+///
+/// Example:
+///
+///   using q16 = mu::fixed<std::int32_t, 16>;
+///   mu::quantity<q16, mu::meter> m{q16{3}};
+///   mu::quantity<q16, mu::millimeter> mm{m};   // 3000 mm, exactly.
+///   auto km = mu::quantity_cast<q16, mu::kilometer, mu::rounding::nearest>(m);
+///   // 0.003 km, rounded to the nearest multiple of 2^-16 km.
+///
+/// \tparam Int The integer holding the value. Must satisfy `std::integral`.
+/// \tparam FracBits Number of fractional bits. Must be less than the number of
+/// value bits of `Int`.
+///
+template <std::integral Int, int FracBits>
+requires(FracBits >= 0 && FracBits < std::numeric_limits<Int>::digits)
+class fixed {
+public:
+  /// Alias for the integer holding the value.
+  using int_type = Int;
+
+  /// Number of fractional bits.
+  constexpr static int frac_bits = FracBits;
+
+  /// Constructs a zero value.
+  constexpr fixed() = default;
+
+  /// Constructs the value of an integer, which must be representable.
+  template <std::integral FromInt>
+  constexpr explicit fixed(FromInt value)
+      : raw_{static_cast<Int>(static_cast<Int>(value) << FracBits)} {}
+
+  /// Constructs a value from its underlying integer, which counts units of
+  /// `2^-FracBits`.
+  constexpr static fixed from_raw(Int raw) noexcept {
+    fixed result;
+    result.raw_ = raw;
+    return result;
+  }
+
+  /// Returns the underlying integer, which counts units of `2^-FracBits`.
+  constexpr Int raw() const noexcept { return raw_; }
+
+  /// Converts the value to a floating-point type, for display.
+  template <std::floating_point Float>
+  constexpr explicit operator Float() const noexcept {
+    return static_cast<Float>(raw_) /
+           static_cast<Float>(std::uintmax_t{1} << FracBits);
+  }
+
+  constexpr fixed operator+() const noexcept { return *this; }
+  constexpr fixed operator-() const noexcept {
+    return from_raw(static_cast<Int>(-raw_));
+  }
+
+  constexpr fixed &operator+=(const fixed &other) noexcept {
+    raw_ = static_cast<Int>(raw_ + other.raw_);
+    return *this;
+  }
+
+  constexpr fixed &operator-=(const fixed &other) noexcept {
+    raw_ = static_cast<Int>(raw_ - other.raw_);
+    return *this;
+  }
+
+  constexpr bool operator==(const fixed &) const = default;
+  constexpr auto operator<=>(const fixed &) const = default;
+
+private:
+  Int raw_ = 0;
+};
+
+namespace detail {
+
+template <class T> struct is_fixed : std::false_type {};
+
+template <std::integral Int, int FracBits>
+struct is_fixed<fixed<Int, FracBits>> : std::true_type {};
+
+/// Concept matches `fixed` types.
+template <class T>
+concept fixed_point = is_fixed<T>::value;
+
+/// Concept matches `fixed` types and fundamental integral types, which are
+/// fixed-point values without fractional bits.
+template <class T>
+concept fixed_or_integral = fixed_point<T> || std::integral<T>;
+
+/// Integer holding the value of a `fixed_or_integral` type.
+template <fixed_or_integral T> constexpr auto fixed_int_type() {
+  if constexpr (fixed_point<T>) {
+    return std::type_identity<typename T::int_type>{};
+  } else {
+    return std::type_identity<T>{};
+  }
+}
+
+template <fixed_or_integral T>
+using fixed_int_t = typename decltype(fixed_int_type<T>())::type;
+
+/// Number of fractional bits of a `fixed_or_integral` type.
+template <fixed_or_integral T>
+constexpr int fixed_frac_bits_v = [] {
+  if constexpr (fixed_point<T>) {
+    return T::frac_bits;
+  } else {
+    return 0;
+  }
+}();
+
+/// Returns the underlying integer of a `fixed_or_integral` value.
+template <fixed_or_integral T> constexpr fixed_int_t<T> fixed_raw(T value) {
+  if constexpr (fixed_point<T>) {
+    return value.raw();
+  } else {
+    return value;
+  }
+}
+
+/// An integer type with twice the width of `Int`, and the same signedness. If
+/// there is no wider fundamental type, this is `Int`.
+template <std::integral Int>
+using wider_int_t = std::conditional_t<
+    /* if   */ sizeof(Int) == 1,
+    /* then */ std::conditional_t<std::is_signed_v<Int>, std::int16_t,
+                                  std::uint16_t>,
+    /* elif */ std::conditional_t<
+        sizeof(Int) == 2,
+        /* then */ std::conditional_t<std::is_signed_v<Int>, std::int32_t,
+                                      std::uint32_t>,
+        /* elif */ std::conditional_t<
+            sizeof(Int) == 4,
+            /* then */ std::conditional_t<std::is_signed_v<Int>, std::int64_t,
+                                          std::uint64_t>,
+            /* else */ Int>>>;
+
+/// Concept is `true` if every value of `From` is a value of `To`: `To` has at
+/// least the integer bits and the fractional bits of `From`, and is signed if
+/// `From` is.
+template <class From, class To>
+concept fixed_fits_in = requires {
+  requires fixed_or_integral<From>;
+  requires fixed_or_integral<To>;
+  requires fixed_frac_bits_v<From> <= fixed_frac_bits_v<To>;
+  requires std::numeric_limits<fixed_int_t<From>>::digits -
+                   fixed_frac_bits_v<From> <=
+               std::numeric_limits<fixed_int_t<To>>::digits -
+                   fixed_frac_bits_v<To>;
+  requires std::is_signed_v<fixed_int_t<To>> ||
+               !std::is_signed_v<fixed_int_t<From>>;
+};
+
+/// A conversion scale that is the ratio `num / den` of integers.
+struct fixed_ratio {
+  bool valid = false;
+  std::intmax_t num = 0;
+  std::intmax_t den = 1;
+};
+
+/// Returns the ratio by which the underlying integer of a value is scaled by
+/// `Conversion`, when its fractional bits change by `Shift`. The ratio is not
+/// valid if the conversion is irrational, or if the ratio overflows.
+template <class Conversion, int Shift>
+constexpr fixed_ratio fixed_scale_ratio() {
+  fixed_ratio ratio;
+  if constexpr (std::integral<typename Conversion::type>) {
+    ratio = {true, Conversion::value, 1};
+  } else if constexpr (Conversion::is_int_ratio) {
+    ratio = {true, Conversion::ratio_num, Conversion::ratio_den};
+  } else {
+    return ratio;
+  }
+  constexpr std::intmax_t max = std::numeric_limits<std::intmax_t>::max();
+  for (int i = 0; i < (Shift < 0 ? -Shift : Shift); ++i) {
+    std::intmax_t &factor = Shift < 0 ? ratio.den : ratio.num;
+    if (factor > max / 2 || factor < -(max / 2)) {
+      return {};
+    }
+    factor *= 2;
+  }
+  // The numerator and denominator are multiplied in `scale_int`.
+  if (ratio.den > max / (ratio.num < 0 ? -ratio.num : ratio.num)) {
+    return {};
+  }
+  return ratio;
+}
+
+/// An integer multiplier and a right shift that approximate a scale.
+struct fixed_multiplier {
+  bool valid = false;
+  std::intmax_t multiplier = 0;
+  int shift = 0;
+};
+
+/// Returns the multiplier and the shift that scale the underlying integer of a
+/// value by `Conversion`, when its fractional bits change by `Shift`. The
+/// underlying integer has `Digits` value bits, and the product of the integer
+/// and the multiplier must fit in a `std::intmax_t`. The multiplier keeps as
+/// many significant bits of the scale as fit. It is not valid if the scale is
+/// too large or too small to be represented.
+template <class Conversion, int Shift, int Digits>
+constexpr fixed_multiplier fixed_scale_multiplier() {
+  constexpr int max_digits = std::numeric_limits<std::intmax_t>::digits - 1;
+  if constexpr (Digits >= max_digits) {
+    return {};
+  } else {
+    long double scale = static_cast<long double>(Conversion::value);
+    const bool negative = scale < 0;
+    scale = negative ? -scale : scale;
+    for (int i = 0; i < Shift; ++i) {
+      scale *= 2;
+    }
+    for (int i = 0; i < -Shift; ++i) {
+      scale /= 2;
+    }
+    long double limit = 1;
+    for (int i = 0; i < max_digits - Digits; ++i) {
+      limit *= 2;
+    }
+    if (scale >= limit) {
+      return {};
+    }
+    int shift = 0;
+    while (shift < max_digits && scale * 2 < limit) {
+      scale *= 2;
+      ++shift;
+    }
+    const auto multiplier = static_cast<std::intmax_t>(scale + 0.5L);
+    if (multiplier == 0) {
+      return {};
+    }
+    return {true, negative ? -multiplier : multiplier, shift};
+  }
+}
+
+/// The change in fractional bits when a `FromRep` is converted to a `fixed`
+/// with `FracBits` fractional bits.
+template <class FromRep, int FracBits>
+constexpr int fixed_shift_v = FracBits - fixed_frac_bits_v<FromRep>;
+
+/// Returns `true` if the ratio of `fixed_scale_ratio` scales the underlying
+/// integer of a `FromRep` in `scale_int`, which only scales unsigned values by
+/// positive ratios.
+template <class Conversion, class FromRep, int FracBits>
+constexpr bool fixed_ratio_applies() {
+  constexpr auto ratio =
+      fixed_scale_ratio<Conversion, fixed_shift_v<FromRep, FracBits>>();
+  return ratio.valid &&
+         (std::is_signed_v<fixed_int_t<FromRep>> || ratio.num > 0);
+}
+
+/// Returns the multiplier that approximates `Conversion` for a `FromRep`.
+template <class Conversion, class FromRep, int FracBits>
+constexpr fixed_multiplier fixed_multiplier_for() {
+  return fixed_scale_multiplier<
+      Conversion, fixed_shift_v<FromRep, FracBits>,
+      std::numeric_limits<fixed_int_t<FromRep>>::digits>();
+}
+
+/// Returns the integer that scales the underlying integer of a `FromRep`
+/// exactly, or zero if there is none, or it is not an `Int`.
+template <class Conversion, class FromRep, class Int, int FracBits>
+constexpr Int fixed_lossless_factor() {
+  constexpr auto ratio =
+      fixed_scale_ratio<Conversion, fixed_shift_v<FromRep, FracBits>>();
+  if constexpr (!ratio.valid || ratio.num % ratio.den != 0) {
+    return 0;
+  } else {
+    constexpr std::intmax_t factor = ratio.num / ratio.den;
+    if constexpr (factor < 0 && !std::is_signed_v<Int>) {
+      return 0;
+    } else if constexpr (factor > std::numeric_limits<Int>::max() ||
+                         factor < std::numeric_limits<Int>::min()) {
+      return 0;
+    } else {
+      return static_cast<Int>(factor);
+    }
+  }
+}
+
+/// Concept is `true` if an arithmetic operation on `fixed` values has a result
+/// with the integer type `Int` and `FracBits` fractional bits, and `Int` has at
+/// least `Digits` value bits to hold every result.
+template <class Int, int FracBits, int Digits = 0>
+concept fixed_result = requires {
+  requires std::integral<Int>;
+  requires FracBits >= 0 && FracBits < std::numeric_limits<Int>::digits;
+  requires std::numeric_limits<Int>::digits >= Digits;
+};
+
+/// The result of a sum or a difference of `fixed` values. It has the integer
+/// bits of the wider operand and the fractional bits of the finer operand, in
+/// the common integer type of the operands if it has enough value bits, and
+/// otherwise in an integer of twice the width. Operands of one type are not
+/// widened, as built-in integers of one type are not.
+template <class LhsInt, int LhsFrac, class RhsInt, int RhsFrac>
+struct fixed_sum {
+  using common_int = std::common_type_t<LhsInt, RhsInt>;
+
+  constexpr static int frac_bits = std::max(LhsFrac, RhsFrac);
+
+  constexpr static int digits =
+      std::max(std::numeric_limits<LhsInt>::digits - LhsFrac,
+               std::numeric_limits<RhsInt>::digits - RhsFrac) +
+      frac_bits;
+
+  using int_type = std::conditional_t<
+      /* if   */ std::numeric_limits<common_int>::digits >= digits,
+      /* then */ common_int,
+      /* else */ wider_int_t<common_int>>;
+};
+
+} // namespace detail
+
+/// Specialization of `rep_traits` for `fixed`. Fixed-point values are cast
+/// from other fixed-point values and from integers, and scaled by unit
+/// conversions without floating-point arithmetic.
+///
+template <std::integral Int, int FracBits>
+struct rep_traits<fixed<Int, FracBits>> {
+  using base_rep_type = Int;
+  using fixed_type = fixed<Int, FracBits>;
+
+  template <detail::fixed_or_integral FromRep>
+  requires detail::fixed_fits_in<FromRep, fixed_type>
+  constexpr static fixed_type lossless_cast(FromRep from_value) {
+    return fixed_type::from_raw(static_cast<Int>(
+        static_cast<Int>(detail::fixed_raw(from_value))
+        << detail::fixed_shift_v<FromRep, FracBits>));
+  }
+
+  /// Casts a value, truncating the fractional bits that do not fit.
+  template <detail::fixed_or_integral FromRep>
+  constexpr static fixed_type lossy_cast(FromRep from_value) {
+    constexpr int shift = detail::fixed_shift_v<FromRep, FracBits>;
+    return fixed_type::from_raw(static_cast<Int>(
+        detail::scale_int<rounding::truncate,
+                          (shift > 0 ? std::intmax_t{1} << shift : 1),
+                          (shift < 0 ? std::intmax_t{1} << -shift : 1)>(
+            detail::fixed_raw(from_value))));
+  }
+
+  /// Scales a value by an integer: the scale of `Conversion`, times the
+  /// additional fractional bits. The value must fit in a `fixed_type`.
+  template <class Conversion, detail::fixed_or_integral FromRep>
+  requires detail::fixed_fits_in<FromRep, fixed_type> &&
+           (detail::fixed_lossless_factor<Conversion, FromRep, Int,
+                                          FracBits>() != 0)
+  constexpr static fixed_type lossless_scale(FromRep from_value) {
+    constexpr Int factor =
+        detail::fixed_lossless_factor<Conversion, FromRep, Int, FracBits>();
+    return fixed_type::from_raw(static_cast<Int>(
+        static_cast<Int>(detail::fixed_raw(from_value)) * factor));
+  }
+
+  /// Scales a value by `Conversion`, rounding the result by `Rounding`. A
+  /// ratio of integers is applied exactly before rounding. Other scales are
+  /// approximated by an integer multiplier and a right shift.
+  template <class Conversion, rounding Rounding,
+            detail::fixed_or_integral FromRep>
+  requires(detail::fixed_ratio_applies<Conversion, FromRep, FracBits>() ||
+           detail::fixed_multiplier_for<Conversion, FromRep, FracBits>().valid)
+  constexpr static fixed_type lossy_scale(FromRep from_value) {
+    const auto raw = detail::fixed_raw(from_value);
+    if constexpr (detail::fixed_ratio_applies<Conversion, FromRep,
+                                              FracBits>()) {
+      constexpr auto ratio =
+          detail::fixed_scale_ratio<Conversion,
+                                    detail::fixed_shift_v<FromRep, FracBits>>();
+      return fixed_type::from_raw(static_cast<Int>(
+          detail::scale_int<Rounding, ratio.num, ratio.den>(raw)));
+    } else {
+      constexpr auto scale =
+          detail::fixed_multiplier_for<Conversion, FromRep, FracBits>();
+      const std::intmax_t product =
+          static_cast<std::intmax_t>(raw) * scale.multiplier;
+      return fixed_type::from_raw(static_cast<Int>(
+          detail::scale_int<Rounding, 1, std::intmax_t{1} << scale.shift>(
+              product)));
+    }
+  }
+};
+
+/// Adds fixed-point values. The sum of values of one type has that type.
+/// Otherwise, it has the integer bits of the wider operand and the fractional
+/// bits of the finer operand (see `detail::fixed_sum`), and operands that would
+/// need more than 64 bits to align cannot be added.
+template <class LhsInt, int LhsFrac, class RhsInt, int RhsFrac,
+          class Sum = detail::fixed_sum<LhsInt, LhsFrac, RhsInt, RhsFrac>>
+requires detail::fixed_result<typename Sum::int_type, Sum::frac_bits,
+                              Sum::digits>
+constexpr auto operator+(const fixed<LhsInt, LhsFrac> &lhs,
+                         const fixed<RhsInt, RhsFrac> &rhs) {
+  using result_type = fixed<typename Sum::int_type, Sum::frac_bits>;
+  return result_type::from_raw(static_cast<typename Sum::int_type>(
+      rep_traits<result_type>::lossy_cast(lhs).raw() +
+      rep_traits<result_type>::lossy_cast(rhs).raw()));
+}
+
+/// Subtracts fixed-point values. The difference has the same integer type and
+/// fractional bits as a sum of the operands.
+template <class LhsInt, int LhsFrac, class RhsInt, int RhsFrac,
+          class Sum = detail::fixed_sum<LhsInt, LhsFrac, RhsInt, RhsFrac>>
+requires detail::fixed_result<typename Sum::int_type, Sum::frac_bits,
+                              Sum::digits>
+constexpr auto operator-(const fixed<LhsInt, LhsFrac> &lhs,
+                         const fixed<RhsInt, RhsFrac> &rhs) {
+  using result_type = fixed<typename Sum::int_type, Sum::frac_bits>;
+  return result_type::from_raw(static_cast<typename Sum::int_type>(
+      rep_traits<result_type>::lossy_cast(lhs).raw() -
+      rep_traits<result_type>::lossy_cast(rhs).raw()));
+}
+
+/// Multiplies fixed-point values exactly. The product has the fractional bits
+/// of both operands, in an integer of twice the width of their common type
+/// (see `detail::wider_int_t`). Operands whose product would need more than 64
+/// bits cannot be multiplied.
+template <class LhsInt, int LhsFrac, class RhsInt, int RhsFrac,
+          class ProductInt =
+              detail::wider_int_t<std::common_type_t<LhsInt, RhsInt>>>
+requires detail::fixed_result<ProductInt, LhsFrac + RhsFrac,
+                              std::numeric_limits<LhsInt>::digits +
+                                  std::numeric_limits<RhsInt>::digits>
+constexpr auto operator*(const fixed<LhsInt, LhsFrac> &lhs,
+                         const fixed<RhsInt, RhsFrac> &rhs) {
+  return fixed<ProductInt, LhsFrac + RhsFrac>::from_raw(
+      static_cast<ProductInt>(static_cast<ProductInt>(lhs.raw()) *
+                              static_cast<ProductInt>(rhs.raw())));
+}
+
+/// Divides fixed-point values. The quotient has the fractional bits of the
+/// dividend, and is truncated toward zero. The dividend is shifted by the
+/// fractional bits of the divisor in an integer of twice the width (see
+/// `detail::wider_int_t`), so values whose shifted dividend would need more
+/// than 64 bits, such as 64-bit values with a fractional divisor, cannot be
+/// divided.
+template <class LhsInt, int LhsFrac, class RhsInt, int RhsFrac,
+          class WorkInt =
+              detail::wider_int_t<std::common_type_t<LhsInt, RhsInt>>>
+requires detail::fixed_result<std::common_type_t<LhsInt, RhsInt>, LhsFrac> &&
+         detail::fixed_result<WorkInt, 0,
+                              std::numeric_limits<LhsInt>::digits + RhsFrac>
+constexpr auto operator/(const fixed<LhsInt, LhsFrac> &lhs,
+                         const fixed<RhsInt, RhsFrac> &rhs) {
+  using quotient_int = std::common_type_t<LhsInt, RhsInt>;
+  return fixed<quotient_int, LhsFrac>::from_raw(static_cast<quotient_int>(
+      static_cast<WorkInt>(static_cast<WorkInt>(lhs.raw()) << RhsFrac) /
+      static_cast<WorkInt>(rhs.raw())));
+}
+
+/// Multiplies a fixed-point value by an integer.
+template <class Int, int FracBits, std::integral Factor>
+requires detail::fixed_result<std::common_type_t<Int, Factor>, FracBits>
+constexpr auto operator*(const fixed<Int, FracBits> &lhs, Factor rhs) {
+  using product_int = std::common_type_t<Int, Factor>;
+  return fixed<product_int, FracBits>::from_raw(static_cast<product_int>(
+      static_cast<product_int>(lhs.raw()) * static_cast<product_int>(rhs)));
+}
+
+/// Multiplies an integer by a fixed-point value.
+template <std::integral Factor, class Int, int FracBits>
+requires detail::fixed_result<std::common_type_t<Int, Factor>, FracBits>
+constexpr auto operator*(Factor lhs, const fixed<Int, FracBits> &rhs) {
+  return rhs * lhs;
+}
+
+/// Divides a fixed-point value by an integer. The quotient is truncated toward
+/// zero.
+template <class Int, int FracBits, std::integral Divisor>
+requires detail::fixed_result<std::common_type_t<Int, Divisor>, FracBits>
+constexpr auto operator/(const fixed<Int, FracBits> &lhs, Divisor rhs) {
+  using quotient_int = std::common_type_t<Int, Divisor>;
+  return fixed<quotient_int, FracBits>::from_raw(static_cast<quotient_int>(
+      static_cast<quotient_int>(lhs.raw()) / static_cast<quotient_int>(rhs)));
+}
+
+} // namespace mu
+
+#endif
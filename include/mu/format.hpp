@@ -0,0 +1,184 @@
+#ifndef INCLUDED_MU_FORMAT_HPP
+#define INCLUDED_MU_FORMAT_HPP
+#include <mu/detail/unit_label.hpp>
+#include <mu/format_options.hpp>
+#include <mu/quantity.hpp>
+#include <mu/units.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace mu::detail {
+
+/// The parsed form of a quantity format spec.
+///
+/// A quantity format spec is a list of fields separated by `;`. The first field
+/// is the format spec of the quantity's value, and it is forwarded unmodified
+/// to the value's own formatter. Each following field is one of these
+/// keywords:
+///
+///   - `name`: display named units by their full names (default).
+///   - `sym`: display named units by their symbols.
+///   - `ascii`: display exponents as ASCII digits (default).
+///   - `sup`: display exponents as UTF-8 superscripts.
+///   - `simp`: display the units in simplified form.
+///
+/// Empty fields are ignored, except the last field, which may instead be any
+/// other text (even empty text) that becomes the mult separator. For example,
+/// `.3f;sym;sup; • ` formats the value with `.3f`, and the units with
+/// symbols, superscript exponents and ` • ` as the separator.
+///
+struct quantity_format_spec {
+  /// Format spec of the quantity's value.
+  std::string_view value_spec;
+
+  /// Selects the label of the units. The `mult_sep` member is unused; see the
+  /// `mult_sep` member of this struct instead.
+  format_options opts;
+
+  /// Separator inserted between units that are multiplied together.
+  std::string_view mult_sep = format_options{}.mult_sep;
+
+  /// If the spec is invalid, this describes the problem. Otherwise `nullptr`.
+  const char *error = nullptr;
+};
+
+/// Parses a quantity format spec. See `quantity_format_spec` for the syntax.
+///
+/// \param spec The format spec, not including the closing `}`.
+///
+constexpr quantity_format_spec
+parse_quantity_format_spec(std::string_view spec) {
+  quantity_format_spec result;
+  auto field_end = spec.find(';');
+  result.value_spec = spec.substr(0, field_end);
+  while (field_end != std::string_view::npos) {
+    spec.remove_prefix(field_end + 1);
+    field_end = spec.find(';');
+    std::string_view field = spec.substr(0, field_end);
+    bool is_last = field_end == std::string_view::npos;
+    if (field.empty() && !is_last) {
+      continue;
+    } else if (field == "name") {
+      result.opts.labels = format_options::label_type::names;
+    } else if (field == "sym") {
+      result.opts.labels = format_options::label_type::symbols;
+    } else if (field == "ascii") {
+      result.opts.superscript_exponents = false;
+    } else if (field == "sup") {
+      result.opts.superscript_exponents = true;
+    } else if (field == "simp") {
+      result.opts.simplified = true;
+    } else if (is_last) {
+      result.mult_sep = field;
+    } else {
+      result.error = "invalid mu::quantity format option";
+      return result;
+    }
+  }
+  return result;
+}
+
+/// Formats the units of a `mu::quantity` according to a quantity format spec.
+///
+/// This is the part of `std::formatter<mu::quantity<Rep, Units>>` that does
+/// not depend on `std::format`, so it is defined, and tested, even with
+/// standard libraries that do not implement `std::format`.
+///
+/// \tparam Units Units of the formatted quantities.
+///
+template <units Units> class quantity_units_formatter {
+public:
+  /// Parses \p spec and selects the label it asks for. If \p spec is invalid,
+  /// the label is not changed.
+  ///
+  /// \param spec The format spec, not including the closing `}`.
+  /// \return The parsed spec, whose `value_spec` is left for the formatter of
+  /// the quantity's value, and whose `error` is set if \p spec is invalid.
+  ///
+  constexpr quantity_format_spec parse(std::string_view spec) {
+    auto parsed = parse_quantity_format_spec(spec);
+    if (!parsed.error) {
+      label_ = &unit_label_table<Units>::get(parsed.opts);
+      mult_sep_ = parsed.mult_sep;
+    }
+    return parsed;
+  }
+
+  /// Writes a space followed by the selected label to \p out. This follows
+  /// the formatted value of the quantity.
+  ///
+  /// \return The iterator past the last character written.
+  ///
+  template <std::output_iterator<char> OutputIt>
+  constexpr OutputIt format(OutputIt out) const {
+    *out++ = ' ';
+    write_unit_label(*label_, mult_sep_,
+                     [&](const char *data, std::size_t size) {
+                       out = std::copy_n(data, size, out);
+                     });
+    return out;
+  }
+
+private:
+  const unit_label *label_ = &unit_label_table<Units>::labels[0];
+  std::string_view mult_sep_ = format_options{}.mult_sep;
+};
+
+} // namespace mu::detail
+
+#if defined(__cpp_lib_format)
+
+/// Formats `mu::quantity` objects with `std::format`.
+///
+/// The format spec is described by `mu::detail::quantity_format_spec`. The spec
+/// is validated at compile-time whenever the format string is. The value is
+/// written by `std::formatter<Rep>`, followed by a space and the precomputed
+/// unit label, directly to the output iterator.
+///
+/// Dynamic width and precision (e.g. `{:{}}`) are not supported in the value's
+/// format spec.
+///
+/// The specialization is only defined if the standard library implements
+/// `std::format`. Everything but the value's formatter is done by
+/// `mu::detail::quantity_units_formatter`, which older libraries, such as
+/// libstdc++ before GCC 13, still provide and test.
+///
+/// \tparam Rep Representation of the quantity.
+/// \tparam Units Units of the quantity.
+///
+template <mu::rep Rep, mu::units Units>
+struct std::formatter<mu::quantity<Rep, Units>, char> {
+public:
+  constexpr auto parse(std::format_parse_context &ctx) {
+    std::string_view spec{ctx.begin(), ctx.end()};
+    spec = spec.substr(0, spec.find('}'));
+    auto parsed = units_formatter_.parse(spec);
+    if (parsed.error) {
+      throw std::format_error(parsed.error);
+    }
+    std::format_parse_context value_ctx{parsed.value_spec};
+    if (value_formatter_.parse(value_ctx) != value_ctx.end()) {
+      throw std::format_error("invalid mu::quantity value format spec");
+    }
+    return ctx.begin() + spec.size();
+  }
+
+  template <class FormatContext>
+  auto format(const mu::quantity<Rep, Units> &q, FormatContext &ctx) const {
+    return units_formatter_.format(value_formatter_.format(q.value(), ctx));
+  }
+
+private:
+  std::formatter<Rep, char> value_formatter_;
+  mu::detail::quantity_units_formatter<Units> units_formatter_;
+};
+
+#endif
+
+#endif
@@ -46,6 +46,19 @@ struct format_options {
   /// character. (For example, `meters^2`).
   ///
   bool superscript_exponents = false;
+
+  /// Whether unit expressions are displayed in simplified form. Default is
+  /// `false`.
+  ///
+  /// If `true`, repeated units are combined, units that cancel out are dropped,
+  /// and units with positive exponents are displayed before units with negative
+  /// exponents. (For example, `meter * meter^-1 * second * meter` is displayed
+  /// as `meter * second`). Named units are never decomposed, and a prefix stays
+  /// attached to the unit that follows it.
+  ///
+  /// If `false`, unit expressions are displayed as written.
+  ///
+  bool simplified = false;
 };
 
 } // namespace mu
@@ -1,19 +1,35 @@
 #ifndef INCLUDED_MU_MU_HPP
 #define INCLUDED_MU_MU_HPP
+#include <mu/charconv.hpp>
+#include <mu/checked_cast.hpp>
+#include <mu/convert.hpp>
 #include <mu/detail/analysis.hpp>
+#include <mu/detail/canonical.hpp>
 #include <mu/detail/compute_pow.hpp>
 #include <mu/detail/concrete_factor.hpp>
 #include <mu/detail/factor.hpp>
 #include <mu/detail/primes.hpp>
 #include <mu/detail/ratio.hpp>
+#include <mu/detail/signature.hpp>
+#include <mu/detail/simplify.hpp>
+#include <mu/detail/static_vector.hpp>
 #include <mu/detail/std_ratio.hpp>
 #include <mu/detail/symbols.hpp>
+#include <mu/detail/type_key.hpp>
+#include <mu/detail/unit_label.hpp>
 #include <mu/detail/unit_string.hpp>
+#include <mu/detail/units_concept.hpp>
+#include <mu/fixed.hpp>
+#include <mu/format.hpp>
 #include <mu/format_options.hpp>
 #include <mu/npow.hpp>
 #include <mu/pow.hpp>
 #include <mu/quantity.hpp>
+#include <mu/quantity_array.hpp>
+#include <mu/quantity_span.hpp>
+#include <mu/reduce.hpp>
 #include <mu/rep.hpp>
+#include <mu/rounding.hpp>
 #include <mu/stream.hpp>
 #include <mu/unit_references.hpp>
 #include <mu/units.hpp>
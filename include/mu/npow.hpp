@@ -3,7 +3,7 @@
 #include <mu/detail/factor.hpp>
 #include <mu/detail/ratio.hpp>
 #include <mu/detail/unit_string.hpp>
-#include <mu/units.hpp>
+#include <mu/detail/units_concept.hpp>
 #include <ratio>
 
 namespace mu {
@@ -67,6 +67,9 @@ struct unit_traits<npow<BaseValue, Exponent>> {
   /// only containing itself.
   using factors = mu::mult<npow<BaseValue, Exponent>>;
 
+  /// The `npow` is a single subexpression.
+  constexpr static std::size_t nesting_depth = 1;
+
   /// Formats the `npow` as `N^exponent`.
   constexpr static void format(unit_string &ustr) {
     ustr.push();
@@ -3,7 +3,7 @@
 #include <mu/detail/factor.hpp>
 #include <mu/detail/ratio.hpp>
 #include <mu/detail/unit_string.hpp>
-#include <mu/units.hpp>
+#include <mu/detail/units_concept.hpp>
 
 namespace mu {
 
@@ -90,6 +90,9 @@ struct unit_traits<pow<UnitsBase, ExpNum, ExpDen>> {
   using factors = typename apply_pow<typename unit_traits<UnitsBase>::factors,
                                      ExpNum, ExpDen>::type;
 
+  /// The pow is one subexpression around its base.
+  constexpr static std::size_t nesting_depth = 1 + nesting_depth_v<UnitsBase>;
+
   /// Push a new subexpression containing the formatted base raised to a power.
   constexpr static void format(unit_string &ustr) {
     ustr.push();
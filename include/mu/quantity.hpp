@@ -1,9 +1,16 @@
 #ifndef INCLUDED_MU_QUANTITY_HPP
 #define INCLUDED_MU_QUANTITY_HPP
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <mu/detail/canonical.hpp>
+#include <mu/pow.hpp>
 #include <mu/rep.hpp>
+#include <mu/rounding.hpp>
 #include <mu/units.hpp>
 #include <mu/units_conversion.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace mu {
 
@@ -54,7 +61,10 @@ template <class FromRep, class FromUnits, class ToRep, class ToUnits>
 concept quantity_losslessly_scalable_to = requires {
   requires units_convertible_to<FromUnits, ToUnits>;
   requires rep_losslessly_scalable_to<FromRep, ToRep,
-                                      units_conversion_t<FromUnits, ToUnits>>;
+                                      units_conversion_t<FromUnits, ToUnits>> ||
+               rep_losslessly_scalable_by<
+                   FromRep, ToRep,
+                   detail::units_conversion<FromUnits, ToUnits>>;
 };
 
 /// Concept is `true` if a `quantity<FromRep, FromUnits>` can be stored in a
@@ -73,7 +83,10 @@ template <class FromRep, class FromUnits, class ToRep, class ToUnits>
 concept quantity_lossily_scalable_to = requires {
   requires units_convertible_to<FromUnits, ToUnits>;
   requires rep_lossily_scalable_to<FromRep, ToRep,
-                                   units_conversion_t<FromUnits, ToUnits>>;
+                                   units_conversion_t<FromUnits, ToUnits>> ||
+               rep_lossily_scalable_by<
+                   FromRep, ToRep,
+                   detail::units_conversion<FromUnits, ToUnits>>;
 };
 
 /// Concept is `true` if a `quantity<FromRep, FromUnits>` can be assigned to a
@@ -148,9 +161,55 @@ concept quantity_only_lossily_convertible_to = requires {
 
 namespace detail {
 
+/// Units of a product of two quantities.
+///
+/// By default, the product is `mult<LhsUnits, RhsUnits>`, so each operation
+/// nests the units one level deeper. If `MU_CANONICAL_ARITHMETIC` is defined,
+/// the product is put into its canonical normal form instead (see
+/// `canonical_units`), which stays flat and is the same type regardless of the
+/// order of the operands. The macro changes the types returned by arithmetic
+/// operators, so it must be defined consistently in every translation unit of
+/// a program (e.g. with the `mu_CANONICAL_ARITHMETIC` CMake option).
+///
+/// \tparam LhsUnits Units on the left-hand side of the product.
+/// \tparam RhsUnits Units on the right-hand side of the product.
+///
+template <class LhsUnits, class RhsUnits>
+#if defined(MU_CANONICAL_ARITHMETIC)
+using product_units_t = canonical_units_t<mult<LhsUnits, RhsUnits>>;
+#else
+using product_units_t = mult<LhsUnits, RhsUnits>;
+#endif
+
+/// Units of a quotient of two quantities. See `product_units_t`.
+///
+/// \tparam LhsUnits Units of the dividend.
+/// \tparam RhsUnits Units of the divisor.
+///
+template <class LhsUnits, class RhsUnits>
+#if defined(MU_CANONICAL_ARITHMETIC)
+using quotient_units_t =
+    canonical_units_t<mult<LhsUnits, pow<RhsUnits, -1>>>;
+#else
+using quotient_units_t = mult<LhsUnits, pow<RhsUnits, -1>>;
+#endif
+
+/// Units of the reciprocal of a quantity. See `product_units_t`.
+///
+/// \tparam Units Units of the quantity.
+///
+template <class Units>
+#if defined(MU_CANONICAL_ARITHMETIC)
+using inverse_units_t = canonical_units_t<pow<Units, -1>>;
+#else
+using inverse_units_t = pow<Units, -1>;
+#endif
+
 /// Convert one representation value to another, accounting for any difference
 /// in units, without loss of precision. If no scaling is required, the result
-/// is cast directly from the argument without any scalar multiplication.
+/// is cast directly from the argument without any scalar multiplication. If
+/// `rep_traits<ToRep>` scales values itself (see `rep_losslessly_scalable_by`),
+/// it does so instead.
 ///
 /// \tparam ToRep Converting to this representation.
 /// \tparam ToUnits Converting to these units.
@@ -165,40 +224,247 @@ constexpr ToRep convert_losslessly(FromRep &&from_value) {
   if constexpr (units_equivalent_to<FromUnits, ToUnits>) {
     return rep_traits<ToRep>::lossless_cast(std::forward<FromRep>(from_value));
 
+  } else if constexpr (rep_losslessly_scalable_by<
+                           std::remove_cvref_t<FromRep>, ToRep,
+                           units_conversion<FromUnits, ToUnits>>) {
+    using conversion = units_conversion<FromUnits, ToUnits>;
+    return rep_traits<ToRep>::template lossless_scale<conversion>(
+        std::forward<FromRep>(from_value));
+
   } else {
-    relaxed_scale_t<ToRep, units_conversion_t<FromUnits, ToUnits>> scale =
-        units_conversion_v<FromUnits, ToUnits>;
-    return rep_traits<ToRep>::lossless_cast(std::forward<FromRep>(from_value) *
-                                            scale);
+    relaxed_scale_t<FromRep, ToRep, units_conversion_t<FromUnits, ToUnits>>
+        scale = units_conversion_v<FromUnits, ToUnits>;
+    if constexpr (std::integral<ToRep> &&
+                  std::integral<std::remove_cvref_t<FromRep>> &&
+                  std::integral<decltype(scale)>) {
+      // Multiply in the destination type, which may be wider than the source.
+      return static_cast<ToRep>(static_cast<ToRep>(from_value) * scale);
+    } else {
+      return rep_traits<ToRep>::lossless_cast(
+          std::forward<FromRep>(from_value) * scale);
+    }
   }
 }
 
+/// Concept is `true` if a fundamental integral `FromRep` can be scaled to a
+/// fundamental integral `ToRep` exactly in integer arithmetic, by multiplying
+/// by the numerator of the conversion ratio and dividing by its denominator.
+///
+/// \tparam FromRep Converting from this representation.
+/// \tparam FromUnits Converting from these units.
+/// \tparam ToRep Converting to this representation.
+/// \tparam ToUnits Converting to these units.
+///
+template <class FromRep, class FromUnits, class ToRep, class ToUnits>
+concept int_ratio_scalable_to = requires {
+  requires std::integral<FromRep>;
+  requires std::integral<ToRep>;
+  requires units_convertible_to<FromUnits, ToUnits>;
+  requires units_conversion<FromUnits, ToUnits>::is_int_ratio;
+  requires std::is_signed_v<FromRep> ||
+               units_conversion<FromUnits, ToUnits>::ratio_num > 0;
+};
+
 /// Convert one representation value to another, accounting for any difference
 /// in units, allowing any potential loss of precision. If no scaling is
 /// required, the result is cast directly from the argument without any scalar
 /// multiplication.
 ///
+/// If `rep_traits<ToRep>` scales values itself (see `rep_lossily_scalable_by`),
+/// it does so, even if the units are equivalent, and rounds by `Rounding`. If
+/// both representations are integral and the conversion is a ratio of
+/// integers, the value is scaled exactly in integer arithmetic. Otherwise, it
+/// is scaled by a floating-point value (see `relaxed_scale_t`). Either way, a
+/// value converted to an integral representation is rounded by `Rounding`.
+///
 /// \tparam ToRep Converting to this representation.
 /// \tparam ToUnits Converting to these units.
 /// \tparam FromUnits Converting from these units.
+/// \tparam Rounding How to round values converted to an integral `ToRep`.
 /// \tparam FromRep Converting from this representation. This template parameter
 /// is last because it can usually be deduced from the argument type.
 /// \param from_value The value to be converted.
 ///
-template <rep ToRep, units ToUnits, units FromUnits, rep FromRep>
+template <rep ToRep, units ToUnits, units FromUnits,
+          rounding Rounding = rounding::truncate, rep FromRep>
 requires quantity_lossily_convertible_to<FromRep, FromUnits, ToRep, ToUnits>
 constexpr ToRep convert_lossily(FromRep &&from_value) {
-  if constexpr (units_equivalent_to<FromUnits, ToUnits>) {
-    return rep_traits<ToRep>::lossy_cast(std::forward<FromRep>(from_value));
+  using from_rep = std::remove_cvref_t<FromRep>;
+  using conversion = units_conversion<FromUnits, ToUnits>;
+
+  if constexpr (rep_lossily_scalable_by<from_rep, ToRep, conversion>) {
+    return rep_traits<ToRep>::template lossy_scale<conversion, Rounding>(
+        std::forward<FromRep>(from_value));
+
+  } else if constexpr (units_equivalent_to<FromUnits, ToUnits>) {
+    if constexpr (std::integral<ToRep> && std::floating_point<from_rep>) {
+      return round_float<Rounding, ToRep>(from_value);
+    } else {
+      return rep_traits<ToRep>::lossy_cast(std::forward<FromRep>(from_value));
+    }
+
+  } else if constexpr (int_ratio_scalable_to<from_rep, FromUnits, ToRep,
+                                             ToUnits>) {
+    return rep_traits<ToRep>::lossy_cast(
+        scale_int<Rounding, conversion::ratio_num, conversion::ratio_den>(
+            from_value));
 
   } else {
-    relaxed_scale_t<ToRep, units_conversion_t<FromUnits, ToUnits>> scale =
-        units_conversion_v<FromUnits, ToUnits>;
-    return rep_traits<ToRep>::lossy_cast(std::forward<FromRep>(from_value) *
-                                         scale);
+    relaxed_scale_t<FromRep, ToRep, units_conversion_t<FromUnits, ToUnits>>
+        scale = units_conversion_v<FromUnits, ToUnits>;
+    if constexpr (std::integral<ToRep> &&
+                  std::floating_point<decltype(from_value * scale)>) {
+      return round_float<Rounding, ToRep>(from_value * scale);
+    } else if constexpr (std::integral<ToRep> && std::integral<from_rep>) {
+      // Multiply in the wider of the two types, so the product does not
+      // overflow a narrower source type before it is cast.
+      using work_type = std::common_type_t<from_rep, ToRep>;
+      return static_cast<ToRep>(static_cast<work_type>(from_value) * scale);
+    } else {
+      return rep_traits<ToRep>::lossy_cast(std::forward<FromRep>(from_value) *
+                                           scale);
+    }
   }
 }
 
+/// True if `Int` holds every value of the integral type `Rep` multiplied by
+/// `Scale`.
+template <class Int, class Rep, std::intmax_t Scale>
+constexpr bool holds_scaled_values() {
+  const Int bound = std::numeric_limits<Int>::max() /
+                    static_cast<Int>(Scale < 0 ? -Scale : Scale);
+  if (std::cmp_greater(std::numeric_limits<Rep>::max(), bound)) {
+    return false;
+  }
+  if constexpr (std::is_signed_v<Int>) {
+    return std::cmp_greater_equal(std::numeric_limits<Rep>::min(), -bound);
+  } else {
+    return true;
+  }
+}
+
+/// The type of the built-in product of a value of the integral type `Rep` and
+/// the integer `Scale`.
+template <std::integral Rep, std::intmax_t Scale>
+using int_product_t = decltype(std::declval<Rep>() * narrowest_int_t<Scale>{});
+
+/// The integer type in which values of the integral type `Rep` are multiplied
+/// by `Scale`. This is the type of the built-in product if it holds every
+/// result, and otherwise the widest integer type of the same signedness.
+///
+/// \tparam Rep The integral type of the values.
+/// \tparam Scale The integer scale.
+///
+template <std::integral Rep, std::intmax_t Scale>
+using scaled_int_t = std::conditional_t<
+    /* if   */ holds_scaled_values<int_product_t<Rep, Scale>, Rep, Scale>(),
+    /* then */ int_product_t<Rep, Scale>,
+    /* else */ std::conditional_t<std::is_signed_v<int_product_t<Rep, Scale>>,
+                                  std::intmax_t, std::uintmax_t>>;
+
+/// The common units of two convertible unit expressions, and how to scale
+/// values measured in either one to the common units.
+///
+/// The common units are the finest units that both `LhsUnits` and `RhsUnits`
+/// are an integer multiple of, so both sides are scaled by integers:
+///
+///   1. If `LhsUnits` is an integer multiple of `RhsUnits` (e.g. kilometers
+///      and meters), the common units are `RhsUnits`.
+///
+///   2. If `RhsUnits` is an integer multiple of `LhsUnits`, the common units
+///      are `LhsUnits`.
+///
+///   3. If the conversion is a ratio `n / d` of integers (e.g. 2 apples and 3
+///      apples), the common units are `RhsUnits` divided by `d`.
+///
+///   4. Otherwise, the conversion is irrational. The common units are
+///      `LhsUnits`, and values measured in `RhsUnits` are scaled by a
+///      floating-point value.
+///
+/// \tparam LhsUnits Units of the left-hand side. Must be convertible to
+/// `RhsUnits`.
+/// \tparam RhsUnits Units of the right-hand side.
+///
+template <units LhsUnits, units RhsUnits> struct common_units {
+private:
+  using conversion = units_conversion<LhsUnits, RhsUnits>;
+
+  constexpr static bool is_lhs_multiple =
+      analysis_object<LhsUnits, RhsUnits>.is_int_convertible;
+
+  constexpr static bool is_rhs_multiple =
+      conversion::is_int_ratio &&
+      (conversion::ratio_num == 1 || conversion::ratio_num == -1);
+
+  constexpr static bool is_ratio = conversion::is_int_ratio;
+
+  /// Scales a value by an integer, unless the integer is 1. Integral values
+  /// are first widened, so that the product does not overflow.
+  template <std::intmax_t Scale, class Rep>
+  constexpr static auto scale_by(Rep &&value) {
+    if constexpr (Scale == 1) {
+      return std::forward<Rep>(value);
+    } else if constexpr (std::integral<std::remove_cvref_t<Rep>>) {
+      using scaled_int = scaled_int_t<std::remove_cvref_t<Rep>, Scale>;
+      return static_cast<scaled_int>(value) * static_cast<scaled_int>(Scale);
+    } else {
+      return std::forward<Rep>(value) * narrowest_int_t<Scale>{Scale};
+    }
+  }
+
+public:
+  /// The common units.
+  using type = std::conditional_t<
+      /* if   */ is_lhs_multiple || (is_ratio && !is_rhs_multiple),
+      /* then */
+      std::conditional_t<is_lhs_multiple, RhsUnits,
+                         mult<std::ratio<1, conversion::ratio_den>, RhsUnits>>,
+      /* else */ LhsUnits>;
+
+  /// Scales a value measured in `LhsUnits` to the common units.
+  template <class Rep> constexpr static auto scale_lhs(Rep &&value) {
+    if constexpr (is_lhs_multiple) {
+      return scale_by<analysis_object<LhsUnits, RhsUnits>.int_conversion>(
+          std::forward<Rep>(value));
+    } else if constexpr (is_ratio && !is_rhs_multiple) {
+      return scale_by<conversion::ratio_num>(std::forward<Rep>(value));
+    } else {
+      return std::forward<Rep>(value);
+    }
+  }
+
+  /// Scales a value measured in `RhsUnits` to the common units.
+  template <class Rep> constexpr static auto scale_rhs(Rep &&value) {
+    if constexpr (is_lhs_multiple) {
+      return std::forward<Rep>(value);
+    } else if constexpr (is_rhs_multiple) {
+      return scale_by<conversion::ratio_den * conversion::ratio_num>(
+          std::forward<Rep>(value));
+    } else if constexpr (is_ratio) {
+      return scale_by<conversion::ratio_den>(std::forward<Rep>(value));
+    } else {
+      using rhs_rep = std::remove_cvref_t<Rep>;
+      relaxed_scale_t<rhs_rep, rhs_rep, units_conversion_t<RhsUnits, LhsUnits>>
+          scale = units_conversion_v<RhsUnits, LhsUnits>;
+      return std::forward<Rep>(value) * scale;
+    }
+  }
+};
+
+/// The common units of two convertible unit expressions. See `common_units`.
+template <units LhsUnits, units RhsUnits>
+using common_units_t = typename common_units<LhsUnits, RhsUnits>::type;
+
+/// Concept is `true` if `LhsUnits` and `RhsUnits` are convertible, but not
+/// equivalent, so values must be scaled to their common units before they are
+/// combined.
+///
+template <class LhsUnits, class RhsUnits>
+concept units_mixed_with = requires {
+  requires units_convertible_to<LhsUnits, RhsUnits>;
+  requires !units_equivalent_to<LhsUnits, RhsUnits>;
+};
+
 } // namespace detail
 
 /// A value that is strongly-typed by its units of measurement.
@@ -240,7 +506,16 @@ public:
   /// their explicit units of measurement.
   ///
   /// \param value The raw value.
-  constexpr explicit quantity(Rep value) : value_{std::move(value)} {}
+  constexpr explicit quantity(Rep value) : value_{std::move(value)} {
+    // A quantity is laid out exactly as its representation, so buffers of
+    // representation values can be viewed as quantities (see `quantity_span`).
+    static_assert(sizeof(quantity) == sizeof(Rep) &&
+                  alignof(quantity) == alignof(Rep));
+    static_assert(std::is_standard_layout_v<quantity> ==
+                  std::is_standard_layout_v<Rep>);
+    static_assert(std::is_trivially_copyable_v<quantity> ==
+                  std::is_trivially_copyable_v<Rep>);
+  }
 
   /// Copy-constructs this quantity from another quantity with compatible units.
   ///
@@ -422,14 +697,48 @@ private:
   Rep value_;
 };
 
+/// Trait is `true` if `T` is a specialization of `quantity`.
+///
+/// \tparam T Inspect this type.
+///
+template <class T> struct is_quantity : std::false_type {};
+
+template <rep Rep, units Units>
+struct is_quantity<quantity<Rep, Units>> : std::true_type {};
+
+template <class T> constexpr bool is_quantity_v = is_quantity<T>::value;
+
+namespace detail {
+
+/// Concept is `true` if `quantity<Rep, Units>` has the same size and alignment
+/// as `Rep`, and both are standard-layout and trivially copyable. A buffer of
+/// `Rep` values can then be viewed as a buffer of quantities without copying.
+///
+template <class Rep, class Units>
+concept layout_compatible_quantity = requires {
+  requires rep<Rep>;
+  requires units<Units>;
+  requires sizeof(quantity<Rep, Units>) == sizeof(Rep);
+  requires alignof(quantity<Rep, Units>) == alignof(Rep);
+  requires std::is_standard_layout_v<quantity<Rep, Units>>;
+  requires std::is_trivially_copyable_v<quantity<Rep, Units>>;
+};
+
+} // namespace detail
+
 /// Converts one quantity to another, acknowledging that the conversion may
 /// result in a loss of precision.
 ///
 /// The source and destination units must be compatible with one another. That
 /// is, they may only differ by a constant scale factor.
 ///
+/// Integral values are converted in integer arithmetic when the conversion is a
+/// ratio of integers, such as from milliseconds to seconds. A value converted
+/// to an integral representation is rounded according to `Rounding`.
+///
 /// \tparam ToRep Representation of the destination quantity.
 /// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round values converted to an integral `ToRep`.
 /// \tparam FromRep Representation of the source quantity.
 /// \tparam FromUnits Units of the source quantity.
 /// \param from_quantity The source quantity, as an lvalue.
@@ -437,12 +746,13 @@ private:
 /// difference in units. Note that precision may have been lost during the
 /// conversion.
 ///
-template <rep ToRep, units ToUnits, rep FromRep, units FromUnits>
+template <rep ToRep, units ToUnits, rounding Rounding = rounding::truncate,
+          rep FromRep, units FromUnits>
 requires quantity_lossily_convertible_to<FromRep, FromUnits, ToRep, ToUnits>
 constexpr quantity<ToRep, ToUnits>
 quantity_cast(const quantity<FromRep, FromUnits> &from_quantity) {
   return quantity<ToRep, ToUnits>{
-      detail::convert_lossily<ToRep, ToUnits, FromUnits>(
+      detail::convert_lossily<ToRep, ToUnits, FromUnits, Rounding>(
           from_quantity.value())};
 }
 
@@ -451,10 +761,12 @@ quantity_cast(const quantity<FromRep, FromUnits> &from_quantity) {
 ///
 /// \tparam ToRep Representation of the destination quantity.
 /// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round values converted to an integral `ToRep`.
 /// \tparam FromRep Representation of the source quantity.
 /// \tparam FromUnits Units of the source quantity.
 ///
-template <rep ToRep, units ToUnits, rep FromRep, units FromUnits>
+template <rep ToRep, units ToUnits, rounding Rounding = rounding::truncate,
+          rep FromRep, units FromUnits>
 requires(!units_convertible_to<FromUnits, ToUnits>)
 constexpr quantity<ToRep, ToUnits>
 quantity_cast(const quantity<FromRep, FromUnits> &) = delete;
@@ -465,8 +777,13 @@ quantity_cast(const quantity<FromRep, FromUnits> &) = delete;
 /// The source and destination units must be compatible with one another. That
 /// is, they may only differ by a constant scale factor.
 ///
+/// Integral values are converted in integer arithmetic when the conversion is a
+/// ratio of integers, such as from milliseconds to seconds. A value converted
+/// to an integral representation is rounded according to `Rounding`.
+///
 /// \tparam ToRep Representation of the destination quantity.
 /// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round values converted to an integral `ToRep`.
 /// \tparam FromRep Representation of the source quantity.
 /// \tparam FromUnits Units of the source quantity.
 /// \param from_quantity The source quantity, as an rvalue.
@@ -474,12 +791,13 @@ quantity_cast(const quantity<FromRep, FromUnits> &) = delete;
 /// difference in units. Note that precision may have been lost during the
 /// conversion.
 ///
-template <rep ToRep, units ToUnits, rep FromRep, units FromUnits>
+template <rep ToRep, units ToUnits, rounding Rounding = rounding::truncate,
+          rep FromRep, units FromUnits>
 requires quantity_lossily_convertible_to<FromRep, FromUnits, ToRep, ToUnits>
 constexpr quantity<ToRep, ToUnits>
 quantity_cast(quantity<FromRep, FromUnits> &&from_quantity) {
   return quantity<ToRep, ToUnits>{
-      detail::convert_lossily<ToRep, ToUnits, FromUnits>(
+      detail::convert_lossily<ToRep, ToUnits, FromUnits, Rounding>(
           std::move(from_quantity).value())};
 }
 
@@ -488,19 +806,20 @@ quantity_cast(quantity<FromRep, FromUnits> &&from_quantity) {
 ///
 /// \tparam ToRep Representation of the destination quantity.
 /// \tparam ToUnits Units of the destination quantity.
+/// \tparam Rounding How to round values converted to an integral `ToRep`.
 /// \tparam FromRep Representation of the source quantity.
 /// \tparam FromUnits Units of the source quantity.
 ///
-template <rep ToRep, units ToUnits, rep FromRep, units FromUnits>
+template <rep ToRep, units ToUnits, rounding Rounding = rounding::truncate,
+          rep FromRep, units FromUnits>
 requires(!units_convertible_to<FromUnits, ToUnits>)
 constexpr quantity<ToRep, ToUnits>
 quantity_cast(quantity<FromRep, FromUnits> &&from_quantity) = delete;
 
 /// Compares quantities for equality.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -517,11 +836,34 @@ constexpr bool operator==(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() == rhs.value();
 }
 
+/// Compares quantities for equality, when their units are convertible but not
+/// equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if the quantities are equal.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator==(const quantity<LhsRep, LhsUnits> &lhs,
+                          const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) == common::scale_rhs(rhs.value());
+}
+
 /// Compares quantities for inequality.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -538,11 +880,34 @@ constexpr bool operator!=(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() != rhs.value();
 }
 
+/// Compares quantities for inequality, when their units are convertible but not
+/// equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if the quantities are not equal.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator!=(const quantity<LhsRep, LhsUnits> &lhs,
+                          const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) != common::scale_rhs(rhs.value());
+}
+
 /// Compares quantities using less-than.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -559,11 +924,34 @@ constexpr bool operator<(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() < rhs.value();
 }
 
+/// Compares quantities using less-than, when their units are convertible but
+/// not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if \p lhs is less than \p rhs.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator<(const quantity<LhsRep, LhsUnits> &lhs,
+                         const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) < common::scale_rhs(rhs.value());
+}
+
 /// Compares quantities using less-than-or-equal.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -581,11 +969,34 @@ constexpr bool operator<=(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() <= rhs.value();
 }
 
+/// Compares quantities using less-than-or-equal, when their units are
+/// convertible but not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if \p lhs is less than or equal to \p rhs.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator<=(const quantity<LhsRep, LhsUnits> &lhs,
+                          const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) <= common::scale_rhs(rhs.value());
+}
+
 /// Compares quantities using greater-than.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -602,11 +1013,34 @@ constexpr bool operator>(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() > rhs.value();
 }
 
+/// Compares quantities using greater-than, when their units are convertible
+/// but not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if \p lhs is greater than \p rhs.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator>(const quantity<LhsRep, LhsUnits> &lhs,
+                         const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) > common::scale_rhs(rhs.value());
+}
+
 /// Compares quantities using greater-than-or-equal.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the comparison, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are compared directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -624,6 +1058,30 @@ constexpr bool operator>=(const quantity<LhsRep, LhsUnits> &lhs,
   return lhs.value() >= rhs.value();
 }
 
+/// Compares quantities using greater-than-or-equal, when their units are
+/// convertible but not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before they are compared. Integral values stay
+/// integral, unless the conversion between the units is irrational, and are
+/// widened as needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the comparison.
+/// \param rhs Quantity on the right-hand side of the comparison.
+/// \return True if \p lhs is greater than or equal to \p rhs.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits>
+constexpr bool operator>=(const quantity<LhsRep, LhsUnits> &lhs,
+                          const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  return common::scale_lhs(lhs.value()) >= common::scale_rhs(rhs.value());
+}
+
 /// Negates a quantity.
 ///
 /// \tparam Rep Representation of the source quantity.
@@ -641,9 +1099,8 @@ constexpr auto operator-(const quantity<Rep, Units> &q) {
 
 /// Adds two quantities.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the addition, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are combined directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -664,11 +1121,38 @@ constexpr auto operator+(const quantity<LhsRep, LhsUnits> &lhs,
   return quantity<sum_rep, LhsUnits>{std::move(sum_value)};
 }
 
+/// Adds two quantities, when their units are convertible but not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before the operation. Integral values stay integral,
+/// unless the conversion between the units is irrational, and are widened as
+/// needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the operator.
+/// \param rhs Quantity on the right-hand side of the operator.
+/// \return A quantity whose value is the sum of the scaled values, measured
+/// in the common units.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits> &&
+         rep_addable<LhsRep, RhsRep>
+constexpr auto operator+(const quantity<LhsRep, LhsUnits> &lhs,
+                         const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  auto sum_value =
+      common::scale_lhs(lhs.value()) + common::scale_rhs(rhs.value());
+  using sum_rep = std::remove_cvref_t<decltype(sum_value)>;
+  return quantity<sum_rep, typename common::type>{std::move(sum_value)};
+}
+
 /// Subtracts one quantity from another.
 ///
-/// The quantities must have equivalent units, because it may be ambiguous what
-/// common units are needed for the addition, and because any implicit
-/// conversion may be expensive for the `Rep` types.
+/// This overload is selected when the quantities have equivalent units, so
+/// their values are combined directly.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
 /// \tparam LhsUnits Units of quantity on the left-hand side.
@@ -691,6 +1175,36 @@ constexpr auto operator-(const quantity<LhsRep, LhsUnits> &lhs,
   return quantity<difference_rep, LhsUnits>{std::move(difference_value)};
 }
 
+/// Subtracts one quantity from another, when their units are convertible but
+/// not equivalent.
+///
+/// Both values are scaled to the common units of the quantities (see
+/// `detail::common_units`) before the operation. Integral values stay integral,
+/// unless the conversion between the units is irrational, and are widened as
+/// needed so that scaling them does not overflow.
+///
+/// \tparam LhsRep Representation of quantity on the left-hand side.
+/// \tparam LhsUnits Units of quantity on the left-hand side.
+/// \tparam RhsRep Representation of quantity on the right-hand side.
+/// \tparam RhsUnits Units of quantity on the right-hand side.
+/// \param lhs Quantity on the left-hand side of the operator.
+/// \param rhs Quantity on the right-hand side of the operator.
+/// \return A quantity whose value is the difference of the scaled values,
+/// measured in the common units.
+///
+template <rep LhsRep, units LhsUnits, rep RhsRep, units RhsUnits>
+requires detail::units_mixed_with<LhsUnits, RhsUnits> &&
+         rep_subtractable<LhsRep, RhsRep>
+constexpr auto operator-(const quantity<LhsRep, LhsUnits> &lhs,
+                         const quantity<RhsRep, RhsUnits> &rhs) {
+  using common = detail::common_units<LhsUnits, RhsUnits>;
+  auto difference_value =
+      common::scale_lhs(lhs.value()) - common::scale_rhs(rhs.value());
+  using difference_rep = std::remove_cvref_t<decltype(difference_value)>;
+  return quantity<difference_rep, typename common::type>{
+      std::move(difference_value)};
+}
+
 /// Multiplies two quantities.
 ///
 /// \tparam LhsRep Representation of quantity on the left-hand side.
@@ -710,7 +1224,7 @@ constexpr auto operator*(const quantity<LhsRep, LhsUnits> &lhs,
                          const quantity<RhsRep, RhsUnits> &rhs) {
   auto product_value = lhs.value() * rhs.value();
   using product_rep = std::remove_cvref_t<decltype(product_value)>;
-  using product_units = mu::mult<LhsUnits, RhsUnits>;
+  using product_units = detail::product_units_t<LhsUnits, RhsUnits>;
   return quantity<product_rep, product_units>{std::move(product_value)};
 }
 
@@ -773,7 +1287,7 @@ constexpr auto operator/(const quantity<LhsRep, LhsUnits> &lhs,
                          const quantity<RhsRep, RhsUnits> &rhs) {
   auto quotient_value = lhs.value() / rhs.value();
   using quotient_rep = std::remove_cvref_t<decltype(quotient_value)>;
-  using quotient_units = mu::mult<LhsUnits, mu::pow<RhsUnits, -1>>;
+  using quotient_units = detail::quotient_units_t<LhsUnits, RhsUnits>;
   return quantity<quotient_rep, quotient_units>{std::move(quotient_value)};
 }
 
@@ -813,10 +1327,36 @@ requires rep_dividable<LhsType, RhsRep>
 constexpr auto operator/(LhsType &&lhs, const quantity<RhsRep, RhsUnits> &rhs) {
   auto quotient_value = std::forward<LhsType>(lhs) / rhs.value();
   using quotient_rep = std::remove_cvref_t<decltype(quotient_value)>;
-  return quantity<quotient_rep, mu::pow<RhsUnits, -1>>{
+  return quantity<quotient_rep, detail::inverse_units_t<RhsUnits>>{
       std::move(quotient_value)};
 }
 
 } // namespace mu
 
+/// The common type of two quantities with convertible units. Its units are the
+/// common units of the quantities (see `mu::detail::common_units`), and its
+/// representation is the common type of the values scaled to those units.
+///
+/// \tparam LhsRep Representation of the first quantity.
+/// \tparam LhsUnits Units of the first quantity.
+/// \tparam RhsRep Representation of the second quantity.
+/// \tparam RhsUnits Units of the second quantity.
+///
+template <mu::rep LhsRep, mu::units LhsUnits, mu::rep RhsRep,
+          mu::units RhsUnits>
+requires mu::units_convertible_to<LhsUnits, RhsUnits>
+struct std::common_type<mu::quantity<LhsRep, LhsUnits>,
+                        mu::quantity<RhsRep, RhsUnits>> {
+private:
+  using common = mu::detail::common_units<LhsUnits, RhsUnits>;
+
+public:
+  using type = mu::quantity<
+      std::common_type_t<
+          decltype(common::scale_lhs(std::declval<LhsRep>())),
+          decltype(common::scale_rhs(std::declval<RhsRep>()))>,
+      std::conditional_t<mu::units_equivalent_to<LhsUnits, RhsUnits>,
+                         LhsUnits, typename common::type>>;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,263 @@
+#ifndef INCLUDED_MU_QUANTITY_ARRAY_HPP
+#define INCLUDED_MU_QUANTITY_ARRAY_HPP
+#include <cstddef>
+#include <memory>
+#include <mu/convert.hpp>
+#include <mu/quantity.hpp>
+#include <mu/rep.hpp>
+#include <mu/units.hpp>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace mu {
+
+/// An allocator that aligns every allocation to `Alignment` bytes. The default
+/// alignment is the size of a cache line, which is also the width of the
+/// widest common vector registers.
+///
+/// \tparam T Type of the allocated objects.
+/// \tparam Alignment Alignment of each allocation, in bytes. Must be a power of
+/// two, and at least the alignment of `T`.
+///
+template <class T, std::size_t Alignment = 64> class aligned_allocator {
+public:
+  static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0,
+                "Alignment must be a power of two");
+  static_assert(Alignment >= alignof(T),
+                "Alignment must be at least the alignment of T");
+
+  using value_type = T;
+
+  /// Alignment of each allocation, in bytes.
+  constexpr static std::size_t alignment = Alignment;
+
+  template <class U> struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+
+  template <class U>
+  constexpr aligned_allocator(
+      const aligned_allocator<U, Alignment> &) noexcept {}
+
+  /// Allocates uninitialized storage for \p count objects.
+  ///
+  /// \throw std::bad_alloc if the storage cannot be allocated.
+  ///
+  T *allocate(std::size_t count) {
+    return static_cast<T *>(
+        ::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  /// Deallocates storage returned by `allocate`.
+  void deallocate(T *ptr, std::size_t count) noexcept {
+    ::operator delete(ptr, count * sizeof(T), std::align_val_t{Alignment});
+  }
+
+  template <class U>
+  constexpr bool
+  operator==(const aligned_allocator<U, Alignment> &) const noexcept {
+    return true;
+  }
+};
+
+/// A fixed-size, contiguous array of quantities that owns its storage.
+///
+/// The representation values are stored contiguously, one per element, and
+/// the storage is aligned by `Alloc`; by default, to 64 bytes. The elements
+/// can be accessed as quantities, or all at once as a span of representation
+/// values to be handed to numeric kernels.
+///
+/// Arrays are move-only, so that buffers are never copied by accident. To copy
+/// an array, or to convert it to other units or another representation,
+/// construct a new array from it, or from a span of it if the type is the
+/// same. The conversion runs as one pass of `mu::convert`.
+///
+/// \tparam Rep The representation of each element. Must satisfy the `rep`
+/// concept.
+/// \tparam Units The units of each element. Must satisfy the `units` concept.
+/// \tparam Alloc Allocator of the storage. It is rebound to allocate
+/// quantities.
+///
+template <rep Rep, units Units, class Alloc = aligned_allocator<Rep>>
+class quantity_array {
+public:
+  /// Alias for the type of each element.
+  using value_type = quantity<Rep, Units>;
+
+  /// Alias for the representation of each element.
+  using rep_type = Rep;
+
+  /// Alias for the units of each element.
+  using units_type = Units;
+
+  using allocator_type = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<value_type>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  static_assert(sizeof(value_type) == sizeof(Rep) &&
+                    std::is_standard_layout_v<value_type>,
+                "quantity must have the layout of its representation");
+
+  /// Constructs an empty array.
+  quantity_array() = default;
+
+  /// Constructs an empty array that uses \p alloc.
+  explicit quantity_array(const Alloc &alloc) noexcept : alloc_{alloc} {}
+
+  /// Constructs an array of \p count value-initialized quantities. Values of
+  /// fundamental representations are zero.
+  ///
+  /// \param count Number of elements.
+  /// \param alloc The allocator.
+  ///
+  explicit quantity_array(size_type count, const Alloc &alloc = Alloc())
+      : alloc_{alloc} {
+    allocate(count);
+    construct([&] { std::uninitialized_value_construct_n(data_, size_); });
+  }
+
+  /// Constructs an array of \p count copies of \p value.
+  ///
+  /// \param count Number of elements.
+  /// \param value Value of each element.
+  /// \param alloc The allocator.
+  ///
+  quantity_array(size_type count, const value_type &value,
+                 const Alloc &alloc = Alloc())
+      : alloc_{alloc} {
+    allocate(count);
+    construct([&] { std::uninitialized_fill_n(data_, size_, value); });
+  }
+
+  /// Constructs an array from a contiguous range of quantities, converting
+  /// each one to `Units` and `Rep` without loss of precision. The range may be
+  /// another `quantity_array`.
+  ///
+  /// \param from The quantities to convert.
+  /// \param alloc The allocator.
+  ///
+  template <class Range>
+  requires detail::quantity_range_convertible_to<Range, quantity_array &>
+  explicit quantity_array(const Range &from, const Alloc &alloc = Alloc())
+      : quantity_array(default_init{}, std::ranges::size(from), alloc) {
+    convert(from, *this);
+  }
+
+  quantity_array(const quantity_array &) = delete;
+  quantity_array &operator=(const quantity_array &) = delete;
+
+  /// Takes ownership of the storage of \p other, which is left empty.
+  quantity_array(quantity_array &&other) noexcept
+      : alloc_{other.alloc_}, data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  /// Releases the storage of this array, and takes ownership of the storage
+  /// of \p other, which is left empty.
+  quantity_array &operator=(quantity_array &&other) noexcept {
+    if (this != &other) {
+      release();
+      alloc_ = other.alloc_;
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~quantity_array() { release(); }
+
+  /// Returns a copy of the allocator.
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  /// Returns the number of elements.
+  size_type size() const noexcept { return size_; }
+
+  /// Returns `true` if the array has no elements.
+  bool empty() const noexcept { return size_ == 0; }
+
+  /// Returns a pointer to the first element, or `nullptr` if the array is
+  /// empty.
+  pointer data() noexcept { return data_; }
+  const_pointer data() const noexcept { return data_; }
+
+  iterator begin() noexcept { return data_; }
+  const_iterator begin() const noexcept { return data_; }
+  iterator end() noexcept { return data_ + size_; }
+  const_iterator end() const noexcept { return data_ + size_; }
+
+  /// Returns the element at \p index, which must be less than `size()`.
+  reference operator[](size_type index) noexcept { return data_[index]; }
+  const_reference operator[](size_type index) const noexcept {
+    return data_[index];
+  }
+
+  /// Returns the representation values of the elements, in order.
+  std::span<Rep> reps() noexcept {
+    return {reinterpret_cast<Rep *>(data_), size_};
+  }
+
+  /// Returns the representation values of the elements, in order.
+  std::span<const Rep> reps() const noexcept {
+    return {reinterpret_cast<const Rep *>(data_), size_};
+  }
+
+private:
+  using traits = std::allocator_traits<allocator_type>;
+
+  struct default_init {};
+
+  /// Constructs an array of \p count default-initialized quantities. Values of
+  /// fundamental representations are indeterminate, until they are assigned.
+  quantity_array(default_init, size_type count, const Alloc &alloc)
+      : alloc_{alloc} {
+    allocate(count);
+    construct([&] { std::uninitialized_default_construct_n(data_, size_); });
+  }
+
+  void allocate(size_type count) {
+    if (count > 0) {
+      data_ = traits::allocate(alloc_, count);
+      size_ = count;
+    }
+  }
+
+  /// Constructs the elements by calling \p init. If it throws, the storage is
+  /// deallocated before the exception propagates.
+  template <class Init> void construct(Init &&init) {
+    try {
+      init();
+    } catch (...) {
+      traits::deallocate(alloc_, data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+      throw;
+    }
+  }
+
+  void release() noexcept {
+    if (data_) {
+      std::destroy_n(data_, size_);
+      traits::deallocate(alloc_, data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  [[no_unique_address]] allocator_type alloc_{};
+  pointer data_ = nullptr;
+  size_type size_ = 0;
+};
+
+} // namespace mu
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef INCLUDED_MU_QUANTITY_SPAN_HPP
+#define INCLUDED_MU_QUANTITY_SPAN_HPP
+#include <cstddef>
+#include <mu/convert.hpp>
+#include <mu/quantity.hpp>
+#include <mu/rep.hpp>
+#include <mu/units.hpp>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace mu {
+
+/// A non-owning view of a contiguous buffer of representation values as
+/// quantities, without copying them.
+///
+/// The view reinterprets the buffer in place. This relies on a quantity having
+/// exactly the layout of its representation, which `quantity.hpp` asserts, so
+/// the view is only available for representations that satisfy
+/// `detail::layout_compatible_quantity`, such as the fundamental types. Since
+/// the buffer is reinterpreted, views cannot be created in constant
+/// expressions.
+///
+/// Example:
+///
+///   double *samples = receive_frame(); // Raw values in meters.
+///   mu::quantity_span<double, mu::meter> meters{samples, count};
+///   for (mu::quantity<double, mu::meter> m : meters) { ... }
+///
+/// \tparam Rep Representation of the viewed values. It may be `const`, in
+/// which case the quantities are read-only.
+/// \tparam Units Units of the viewed values.
+/// \tparam Extent Number of values, or `std::dynamic_extent`.
+///
+template <class Rep, units Units, std::size_t Extent = std::dynamic_extent>
+requires detail::layout_compatible_quantity<std::remove_const_t<Rep>, Units>
+class quantity_span {
+public:
+  /// Alias for the quantity type of each element, without `const`.
+  using value_type = quantity<std::remove_const_t<Rep>, Units>;
+
+  /// Alias for the quantity type of each element, `const` if `Rep` is.
+  using element_type =
+      std::conditional_t<std::is_const_v<Rep>, const value_type, value_type>;
+
+  /// Alias for the representation of each element.
+  using rep_type = Rep;
+
+  /// Alias for the units of each element.
+  using units_type = Units;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = element_type *;
+  using const_pointer = const element_type *;
+  using reference = element_type &;
+  using const_reference = const element_type &;
+  using iterator = element_type *;
+
+  /// Number of elements, or `std::dynamic_extent`.
+  constexpr static std::size_t extent = Extent;
+
+  /// Constructs an empty view.
+  constexpr quantity_span() noexcept
+  requires(Extent == 0 || Extent == std::dynamic_extent)
+  = default;
+
+  /// Views a buffer of representation values.
+  ///
+  /// This constructor is explicit to encourage co-locating raw values with
+  /// their explicit units of measurement.
+  ///
+  /// \param reps The buffer of representation values.
+  ///
+  explicit quantity_span(std::span<Rep, Extent> reps) noexcept
+      : data_{reinterpret_cast<pointer>(reps.data())}, size_{reps.size()} {}
+
+  /// Views \p count representation values starting at \p data.
+  ///
+  /// \param data The first representation value.
+  /// \param count Number of values. Must equal `Extent`, unless it is
+  /// `std::dynamic_extent`.
+  ///
+  quantity_span(Rep *data, size_type count) noexcept
+      : quantity_span{std::span<Rep, Extent>{data, count}} {}
+
+  /// Views the same buffer as \p other, which may have mutable values, or a
+  /// static extent.
+  ///
+  /// \param other The view to copy.
+  ///
+  template <class OtherRep, std::size_t OtherExtent>
+  requires(!std::is_same_v<OtherRep, Rep> || OtherExtent != Extent) &&
+          std::is_convertible_v<OtherRep (*)[], Rep (*)[]> &&
+          (Extent == std::dynamic_extent || Extent == OtherExtent)
+  quantity_span(
+      const quantity_span<OtherRep, Units, OtherExtent> &other) noexcept
+      : quantity_span{other.reps()} {}
+
+  /// Returns the number of elements.
+  constexpr size_type size() const noexcept { return size_; }
+
+  /// Returns the size of the viewed buffer, in bytes.
+  constexpr size_type size_bytes() const noexcept {
+    return size_ * sizeof(Rep);
+  }
+
+  /// Returns `true` if the view has no elements.
+  constexpr bool empty() const noexcept { return size_ == 0; }
+
+  /// Returns a pointer to the first element.
+  constexpr pointer data() const noexcept { return data_; }
+
+  constexpr iterator begin() const noexcept { return data_; }
+  constexpr iterator end() const noexcept { return data_ + size_; }
+
+  /// Returns the element at \p index, which must be less than `size()`.
+  constexpr reference operator[](size_type index) const noexcept {
+    return data_[index];
+  }
+
+  /// Returns the first element. The view must not be empty.
+  constexpr reference front() const noexcept { return data_[0]; }
+
+  /// Returns the last element. The view must not be empty.
+  constexpr reference back() const noexcept { return data_[size_ - 1]; }
+
+  /// Returns a view of the first \p count elements.
+  quantity_span<Rep, Units> first(size_type count) const noexcept {
+    return {reps().data(), count};
+  }
+
+  /// Returns a view of the last \p count elements.
+  quantity_span<Rep, Units> last(size_type count) const noexcept {
+    return {reps().data() + (size_ - count), count};
+  }
+
+  /// Returns a view of \p count elements starting at \p offset. If \p count
+  /// is `std::dynamic_extent`, the view extends to the end.
+  quantity_span<Rep, Units>
+  subspan(size_type offset,
+          size_type count = std::dynamic_extent) const noexcept {
+    return {reps().data() + offset,
+            count == std::dynamic_extent ? size_ - offset : count};
+  }
+
+  /// Returns the viewed buffer of representation values.
+  std::span<Rep, Extent> reps() const noexcept {
+    return std::span<Rep, Extent>{reinterpret_cast<Rep *>(data_), size_};
+  }
+
+  /// Returns a lazy view of the elements converted to `ToRep` and `ToUnits`.
+  /// Each element is converted, without loss of precision, when it is read,
+  /// and the viewed buffer is never copied.
+  ///
+  /// \tparam ToRep Representation of the converted quantities.
+  /// \tparam ToUnits Units of the converted quantities.
+  ///
+  template <rep ToRep, units ToUnits>
+  requires quantity_losslessly_convertible_to<std::remove_const_t<Rep>, Units,
+                                              ToRep, ToUnits>
+  constexpr auto as() const noexcept {
+    return std::views::transform(
+        std::span<element_type, Extent>{data_, size_},
+        detail::rep_converter<value_type, quantity<ToRep, ToUnits>>{});
+  }
+
+private:
+  pointer data_ = nullptr;
+  size_type size_ = 0;
+};
+
+} // namespace mu
+
+template <class Rep, mu::units Units, std::size_t Extent>
+constexpr bool
+    std::ranges::enable_borrowed_range<mu::quantity_span<Rep, Units, Extent>> =
+        true;
+
+template <class Rep, mu::units Units, std::size_t Extent>
+constexpr bool
+    std::ranges::enable_view<mu::quantity_span<Rep, Units, Extent>> = true;
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef INCLUDED_MU_REDUCE_HPP
+#define INCLUDED_MU_REDUCE_HPP
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <mu/convert.hpp>
+#include <mu/quantity.hpp>
+#include <mu/units.hpp>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mu {
+
+/// How `mu::reduce` algorithms add floating-point values. Integral values are
+/// always added exactly, in order.
+///
+enum class summation {
+  /// Adds the values in a balanced tree of blocks. The rounding error grows
+  /// with the logarithm of the number of values, and the blocks are added in
+  /// independent lanes that can be vectorized. This is the default.
+  pairwise,
+
+  /// Adds the values with Neumaier's compensated summation, which carries the
+  /// rounding error of each addition in a second accumulator. The rounding
+  /// error does not grow with the number of values, but each addition costs
+  /// several times as much as a pairwise one.
+  compensated,
+};
+
+namespace detail {
+
+/// Number of independent accumulators used by the reduction kernels. The
+/// lanes are updated in a fixed order, so compilers can vectorize the kernels
+/// without reassociating floating-point additions.
+constexpr std::size_t reduce_lanes = 8;
+
+/// Largest number of values that `sum_values` adds as one block. Must be a
+/// multiple of `reduce_lanes`.
+constexpr std::size_t pairwise_block_size = 16 * reduce_lanes;
+
+/// Adds \p value to the compensated sum \p sum, whose rounding error is
+/// accumulated in \p error.
+template <class T> constexpr void add_compensated(T &sum, T &error, T value) {
+  const T total = sum + value;
+  // Selecting the operands, rather than the expression, and taking magnitudes
+  // with `std::fabs` keep the update free of branches, so lanes of it can be
+  // vectorized. `std::fabs` is not constexpr until C++23.
+  const bool sum_is_larger =
+      std::is_constant_evaluated()
+          ? (sum < 0 ? -sum : sum) >= (value < 0 ? -value : value)
+          : std::fabs(sum) >= std::fabs(value);
+  const T larger = sum_is_larger ? sum : value;
+  const T smaller = sum_is_larger ? value : sum;
+  error += (larger - total) + smaller;
+  sum = total;
+}
+
+/// Adds \p count values returned by `load(first)`, `load(first + 1)`, ... as
+/// a `T`, according to `Summation`.
+///
+/// \tparam T Type of the sum.
+/// \tparam Summation How to add floating-point values.
+/// \param first Index of the first value.
+/// \param count Number of values.
+/// \param load Function that returns the value at an index.
+///
+template <class T, summation Summation, class Load>
+constexpr T sum_values(std::size_t first, std::size_t count,
+                       const Load &load) {
+  if constexpr (std::floating_point<T> &&
+                Summation == summation::compensated) {
+    T sums[reduce_lanes]{};
+    T errors[reduce_lanes]{};
+    std::size_t i = 0;
+    for (; i + reduce_lanes <= count; i += reduce_lanes) {
+      for (std::size_t j = 0; j < reduce_lanes; ++j) {
+        add_compensated(sums[j], errors[j],
+                        static_cast<T>(load(first + i + j)));
+      }
+    }
+    T sum{};
+    T error{};
+    for (; i < count; ++i) {
+      add_compensated(sum, error, static_cast<T>(load(first + i)));
+    }
+    for (std::size_t j = 0; j < reduce_lanes; ++j) {
+      add_compensated(sum, error, sums[j]);
+      error += errors[j];
+    }
+    return sum + error;
+
+  } else if constexpr (std::floating_point<T>) {
+    if (count > pairwise_block_size) {
+      // Split at a multiple of the lane count, so every block but the last is
+      // added entirely in lanes.
+      const std::size_t half = count / 2 / reduce_lanes * reduce_lanes;
+      return sum_values<T, Summation>(first, half, load) +
+             sum_values<T, Summation>(first + half, count - half, load);
+    }
+    T lanes[reduce_lanes]{};
+    std::size_t i = 0;
+    for (; i + reduce_lanes <= count; i += reduce_lanes) {
+      for (std::size_t j = 0; j < reduce_lanes; ++j) {
+        lanes[j] += static_cast<T>(load(first + i + j));
+      }
+    }
+    for (std::size_t j = 0; i < count; ++i, ++j) {
+      lanes[j] += static_cast<T>(load(first + i));
+    }
+    for (std::size_t width = reduce_lanes / 2; width > 0; width /= 2) {
+      for (std::size_t j = 0; j < width; ++j) {
+        lanes[j] += lanes[j + width];
+      }
+    }
+    return lanes[0];
+
+  } else {
+    T sum{};
+    for (std::size_t i = 0; i < count; ++i) {
+      sum += static_cast<T>(load(first + i));
+    }
+    return sum;
+  }
+}
+
+/// Returns the least of \p count values returned by `load(first)`, ... if
+/// `Less` orders values by `<`, or the greatest if it orders them by `>`.
+/// \p count must not be zero.
+///
+template <class T, class Less, class Load>
+constexpr T extremum_values(std::size_t first, std::size_t count,
+                            const Load &load) {
+  const Less less;
+  T lanes[reduce_lanes];
+  for (std::size_t j = 0; j < reduce_lanes; ++j) {
+    lanes[j] = load(first);
+  }
+  std::size_t i = 0;
+  for (; i + reduce_lanes <= count; i += reduce_lanes) {
+    for (std::size_t j = 0; j < reduce_lanes; ++j) {
+      const T value = load(first + i + j);
+      lanes[j] = less(value, lanes[j]) ? value : lanes[j];
+    }
+  }
+  for (; i < count; ++i) {
+    const T value = load(first + i);
+    lanes[0] = less(value, lanes[0]) ? value : lanes[0];
+  }
+  for (std::size_t j = 1; j < reduce_lanes; ++j) {
+    lanes[0] = less(lanes[j], lanes[0]) ? lanes[j] : lanes[0];
+  }
+  return lanes[0];
+}
+
+/// Loads the representation value of each quantity in a buffer.
+template <class Quantity> struct load_value {
+  const Quantity *data;
+  constexpr auto operator()(std::size_t i) const { return data[i].value(); }
+};
+
+/// Loads the square of the representation value of each quantity in a buffer.
+template <class Quantity> struct load_square {
+  const Quantity *data;
+  constexpr auto operator()(std::size_t i) const {
+    return data[i].value() * data[i].value();
+  }
+};
+
+/// Loads the product of the representation values of the quantities at the
+/// same index of two buffers.
+template <class LhsQuantity, class RhsQuantity> struct load_product {
+  const LhsQuantity *lhs;
+  const RhsQuantity *rhs;
+  constexpr auto operator()(std::size_t i) const {
+    return lhs[i].value() * rhs[i].value();
+  }
+};
+
+/// Representation of the sum of quantities of a `quantity_range`, which is the
+/// representation of their sum by `operator+`.
+template <quantity_range Range>
+using sum_rep_t = std::remove_cvref_t<decltype(
+    std::declval<typename range_quantity_t<Range>::rep_type>() +
+    std::declval<typename range_quantity_t<Range>::rep_type>())>;
+
+/// Type of the product of the quantities of two `quantity_range`s by
+/// `operator*`.
+template <quantity_range LhsRange, quantity_range RhsRange>
+using product_quantity_t = decltype(std::declval<range_quantity_t<LhsRange>>() *
+                                    std::declval<range_quantity_t<RhsRange>>());
+
+/// Concept matches `quantity_range`s of quantities with an arithmetic
+/// representation, which the reduction kernels can add and compare.
+template <class Range>
+concept arithmetic_quantity_range = requires {
+  requires quantity_range<Range>;
+  requires std::is_arithmetic_v<typename range_quantity_t<Range>::rep_type>;
+};
+
+/// Returns the quantities of \p range as a span.
+template <quantity_range Range>
+constexpr std::span<const range_quantity_t<Range>>
+quantities_of(const Range &range) {
+  return std::span<const range_quantity_t<Range>>{range};
+}
+
+/// Checks that the ranges of a dot product have the same size.
+///
+/// \throw std::length_error if the sizes differ.
+///
+constexpr void check_dot_sizes(std::size_t lhs, std::size_t rhs) {
+  if (lhs != rhs) {
+    throw std::length_error("mu::reduce::dot of ranges of different sizes");
+  }
+}
+
+} // namespace detail
+
+/// Reductions over contiguous ranges of quantities, such as `std::vector`,
+/// `std::span`, `mu::quantity_array` or `mu::quantity_span` of quantities with
+/// arithmetic representations.
+///
+/// The units of each result follow the rules of the arithmetic operators: a
+/// sum has the units of its terms, and a product has the product of their
+/// units. The kernels add and compare values in independent lanes, so they are
+/// vectorized without relaxing floating-point semantics. Overloads that take an
+/// execution policy are declared in `mu/execution.hpp`.
+///
+namespace reduce {
+
+/// Adds the quantities of \p range.
+///
+/// \tparam Summation How to add floating-point values.
+/// \param range The quantities to add.
+/// \return The sum, in the units of the quantities. Its representation is that
+/// of the sum of two quantities. The sum of no quantities is zero.
+///
+template <summation Summation = summation::pairwise, class Range>
+requires detail::arithmetic_quantity_range<Range>
+constexpr auto sum(const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using sum_rep = detail::sum_rep_t<Range>;
+  const auto values = detail::quantities_of(range);
+  return quantity<sum_rep, typename quantity_type::units_type>{
+      detail::sum_values<sum_rep, Summation>(
+          0, values.size(),
+          detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Computes the arithmetic mean of the quantities of \p range, which must not
+/// be empty.
+///
+/// \tparam Summation How to add floating-point values.
+/// \param range The quantities to average.
+/// \return The sum of the quantities divided by their number. Integral means
+/// are truncated, as by integer division.
+///
+template <summation Summation = summation::pairwise, class Range>
+requires detail::arithmetic_quantity_range<Range>
+constexpr auto mean(const Range &range) {
+  const auto total = reduce::sum<Summation>(range);
+  using result_type = std::remove_cvref_t<decltype(total)>;
+  using sum_rep = typename result_type::rep_type;
+  return result_type{total.value() /
+                     static_cast<sum_rep>(std::ranges::size(range))};
+}
+
+/// Returns the least of the quantities of \p range, which must not be empty.
+///
+template <class Range>
+requires detail::arithmetic_quantity_range<Range>
+constexpr detail::range_quantity_t<Range> min(const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  const auto values = detail::quantities_of(range);
+  return quantity_type{detail::extremum_values<rep_type, std::less<>>(
+      0, values.size(), detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Returns the greatest of the quantities of \p range, which must not be
+/// empty.
+///
+template <class Range>
+requires detail::arithmetic_quantity_range<Range>
+constexpr detail::range_quantity_t<Range> max(const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  const auto values = detail::quantities_of(range);
+  return quantity_type{detail::extremum_values<rep_type, std::greater<>>(
+      0, values.size(), detail::load_value<quantity_type>{values.data()})};
+}
+
+/// Computes the dot product of two ranges of quantities of the same size.
+///
+/// \tparam Summation How to add floating-point products.
+/// \param lhs The quantities on the left-hand side of each product.
+/// \param rhs The quantities on the right-hand side of each product.
+/// \return The sum of the products of the quantities at the same index, with
+/// the type of the product of two quantities.
+/// \throw std::length_error if the ranges have different sizes.
+///
+template <summation Summation = summation::pairwise, class LhsRange,
+          class RhsRange>
+requires detail::arithmetic_quantity_range<LhsRange> &&
+         detail::arithmetic_quantity_range<RhsRange>
+constexpr auto dot(const LhsRange &lhs, const RhsRange &rhs) {
+  using result_type = detail::product_quantity_t<LhsRange, RhsRange>;
+  const auto lhs_values = detail::quantities_of(lhs);
+  const auto rhs_values = detail::quantities_of(rhs);
+  detail::check_dot_sizes(lhs_values.size(), rhs_values.size());
+  return result_type{
+      detail::sum_values<typename result_type::rep_type, Summation>(
+          0, lhs_values.size(),
+          detail::load_product<detail::range_quantity_t<LhsRange>,
+                               detail::range_quantity_t<RhsRange>>{
+              lhs_values.data(), rhs_values.data()})};
+}
+
+/// Adds the squares of the quantities of \p range.
+///
+/// \tparam Summation How to add floating-point squares.
+/// \param range The quantities to square and add.
+/// \return The sum of the squares, with the type of the product of two
+/// quantities.
+///
+template <summation Summation = summation::pairwise, class Range>
+requires detail::arithmetic_quantity_range<Range>
+constexpr auto sum_of_squares(const Range &range) {
+  using quantity_type = detail::range_quantity_t<Range>;
+  using result_type = detail::product_quantity_t<Range, Range>;
+  const auto values = detail::quantities_of(range);
+  return result_type{
+      detail::sum_values<typename result_type::rep_type, Summation>(
+          0, values.size(),
+          detail::load_square<quantity_type>{values.data()})};
+}
+
+/// Computes the Euclidean norm of the quantities of \p range: the square root
+/// of the sum of their squares.
+///
+/// \tparam Summation How to add floating-point squares.
+/// \param range The quantities.
+/// \return The norm, in the units of the quantities. Its representation is the
+/// type returned by `std::sqrt`.
+///
+template <summation Summation = summation::pairwise, class Range>
+requires detail::arithmetic_quantity_range<Range>
+auto norm(const Range &range) {
+  using units_type = typename detail::range_quantity_t<Range>::units_type;
+  const auto root = std::sqrt(reduce::sum_of_squares<Summation>(range).value());
+  return quantity<std::remove_const_t<decltype(root)>, units_type>{root};
+}
+
+} // namespace reduce
+
+} // namespace mu
+
+#endif
@@ -1,7 +1,11 @@
 #ifndef INCLUDED_MU_REP_HPP
 #define INCLUDED_MU_REP_HPP
 #include <concepts>
+#include <cstddef>
 #include <limits>
+#include <mu/rounding.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace mu {
 
@@ -47,6 +51,23 @@ template <class T> struct rep_traits {};
 ///      must provide an implementation where `FromType = T`, because a `T` is
 ///      certainly lossily constructable from another `T`.
 ///
+/// The specialization may also define a floating-point member type
+/// `scale_type`. If present, values converted to `T` are multiplied by
+/// non-integer scales of this type. Otherwise, the scale type is chosen from
+/// the precision of `base_rep_type`.
+///
+/// The specialization may also scale values itself, instead of multiplying
+/// them by the scale of a unit conversion, by defining static member templates
+/// `lossless_scale<Conversion>(from_value)` and
+/// `lossy_scale<Conversion, Rounding>(from_value)`. `Conversion` is the
+/// `detail::units_conversion` of the units, and `Rounding` is a `rounding`. See
+/// `rep_losslessly_scalable_by` and `rep_lossily_scalable_by`.
+///
+/// Types that hold several values in lanes, such as SIMD vectors, may also
+/// define a static constant `lane_count`. Each lane is a `base_rep_type`, and
+/// values converted to `T` are scaled by a `base_rep_type` (see
+/// `relaxed_scale_t`), so the scale is broadcast to every lane.
+///
 template <class T>
 concept rep = requires(T lvalue, T &&rvalue) {
   requires base_rep<typename rep_traits<T>::base_rep_type>;
@@ -87,29 +108,103 @@ concept int_fits_in_float = requires {
   requires std::numeric_limits<From>::digits <= std::numeric_limits<To>::digits;
 };
 
-/// Actual type used to scale to a `ToRep`.
+/// The narrowest floating-point type whose significand represents every value
+/// of the fundamental type `T`. If no type is wide enough, this is
+/// `long double`.
+///
+template <base_rep T>
+using exact_float_t = std::conditional_t<
+    /* if   */ std::numeric_limits<T>::digits <=
+                   std::numeric_limits<float>::digits,
+    /* then */ float,
+    /* elif */ std::conditional_t<std::numeric_limits<T>::digits <=
+                                      std::numeric_limits<double>::digits,
+                                  /* then */ double,
+                                  /* else */ long double>>;
+
+/// Concept matches `rep` types whose `rep_traits` choose the floating-point
+/// type of non-integer scales.
+///
+template <class Rep>
+concept rep_with_scale_type = requires {
+  requires rep<Rep>;
+  requires std::floating_point<typename rep_traits<Rep>::scale_type>;
+};
+
+/// Concept matches `rep` types that hold `rep_traits<Rep>::lane_count` values
+/// of their `base_rep_type`, such as SIMD vectors.
 ///
-/// If the conversion between units is a floating point value, the scale itself
-/// is a `long double` to prevent losing as much information as possible.
-/// However, if all floating-point conversions were performed with `long
-/// double`, then the resulting data-type would never be wide enough to hold the
-/// scaled value unless the resulting data-type itself were a `long double`.
+template <class Rep>
+concept vector_rep = requires {
+  requires rep<Rep>;
+  requires rep_traits<Rep>::lane_count > 0;
+};
+
+/// Selects the type of the scale when converting a `FromRep` to a `ToRep`. See
+/// `relaxed_scale_t`.
+template <class FromRep, class ToRep, class Scale>
+requires rep<std::remove_cvref_t<FromRep>> && rep<ToRep>
+constexpr auto select_relaxed_scale() {
+  using from_base =
+      typename rep_traits<std::remove_cvref_t<FromRep>>::base_rep_type;
+  using to_base = typename rep_traits<ToRep>::base_rep_type;
+  if constexpr (vector_rep<ToRep> &&
+                (std::floating_point<to_base> ||
+                 (!std::floating_point<Scale> &&
+                  brace_convertible_to<Scale, to_base>))) {
+    return std::type_identity<to_base>{};
+  } else if constexpr (!std::floating_point<Scale>) {
+    return std::type_identity<Scale>{};
+  } else if constexpr (rep_with_scale_type<ToRep>) {
+    return std::type_identity<typename rep_traits<ToRep>::scale_type>{};
+  } else if constexpr (std::floating_point<to_base>) {
+    return std::type_identity<to_base>{};
+  } else if constexpr (std::numeric_limits<from_base>::digits >
+                       std::numeric_limits<to_base>::digits) {
+    return std::type_identity<exact_float_t<from_base>>{};
+  } else {
+    return std::type_identity<exact_float_t<to_base>>{};
+  }
+}
+
+/// Actual type used to scale a `FromRep` to a `ToRep`.
 ///
-/// To address this, if the resulting data-type is a floating-point value, the
-/// scale is casted - or "relaxed" - to the resulting data-type, so the
-/// conversion would appear to not lose any precision. If neither the resulting
-/// data-type nor the scale is a floating-point value, then the unmodified scale
-/// is used, and no relaxation takes place.
+/// If the conversion between units is a floating point value, it is computed
+/// as a `long double`. Scaling by a `long double` is slow on many platforms,
+/// and prevents vectorization. It would also make the result a `long double`,
+/// which is never wide enough to hold the scaled value unless `ToRep` itself
+/// is a `long double`.
 ///
+/// To address this, a floating-point scale is casted - or "relaxed" - to the
+/// narrowest type that preserves the precision of the conversion:
+///
+///   1. If `ToRep` is a `vector_rep` with floating-point lanes, the scale is
+///      the type of its lanes, because vector types are only multiplied by
+///      scalars of their lane type.
+///
+///   2. Otherwise, if `rep_traits<ToRep>` defines a floating-point
+///      `scale_type`, the scale is that type.
+///
+///   3. Otherwise, if `ToRep` is a floating-point rep, the scale is its base
+///      rep type, so the conversion appears to not lose any precision.
+///
+///   4. Otherwise, the scale is the narrowest floating-point type that can
+///      hold every value of both `FromRep` and `ToRep`. For example, `int16_t`
+///      is scaled by a `float`, and `int32_t` by a `double`.
+///
+/// If the scale is an integer, the unmodified scale is used, and no relaxation
+/// takes place, unless `ToRep` is a `vector_rep` whose lanes hold every value
+/// of the scale type. Then the scale is cast to the type of its lanes, as it
+/// would be by the multiplication of a scalar type.
+///
+/// \tparam FromRep Representation type that holds the value being scaled.
 /// \tparam ToRep Representation type that holds the result of a scaling
 /// conversion.
 /// \tparam Scale Type of the scale during a scaling conversion.
 ///
-template <class ToRep, class Scale>
-using relaxed_scale_t = std::conditional_t<
-    /* if   */ floating_point_rep<ToRep> && std::floating_point<Scale>,
-    /* then */ typename rep_traits<ToRep>::base_rep_type,
-    /* else */ Scale>;
+template <class FromRep, class ToRep, class Scale>
+using relaxed_scale_t =
+    typename decltype(select_relaxed_scale<FromRep, ToRep, Scale>())::type;
 
 } // namespace detail
 
@@ -164,9 +259,39 @@ concept rep_lossily_castable_to = requires(FromRep from_value) {
   { rep_traits<ToRep>::lossy_cast(from_value) } -> std::same_as<ToRep>;
 };
 
+namespace detail {
+
+/// Concept is `true` if a value of type `FromRep`, multiplied by a `Scale`
+/// relaxed for `ToRep`, can be stored in a `ToRep` without loss of precision.
+template <class FromRep, class ToRep, class Scale>
+concept value_losslessly_scalable_to = requires(
+    FromRep from_value, relaxed_scale_t<FromRep, ToRep, Scale> scale_value) {
+  requires rep_losslessly_castable_to<FromRep, ToRep>;
+  requires rep_losslessly_castable_to<decltype(from_value * scale_value),
+                                      ToRep>;
+};
+
+/// Concept is `true` if a value of type `FromRep`, multiplied by a `Scale`
+/// relaxed for `ToRep`, can be stored in a `ToRep`, even if this would lose
+/// precision.
+template <class FromRep, class ToRep, class Scale>
+concept value_lossily_scalable_to = requires(
+    FromRep from_value, relaxed_scale_t<FromRep, ToRep, Scale> scale_value) {
+  requires rep_lossily_castable_to<FromRep, ToRep>;
+  requires rep_lossily_castable_to<decltype(from_value * scale_value), ToRep>;
+};
+
+/// The type of the lanes of `Rep`, or `Rep` itself if it is a scalar.
+template <class Rep>
+using lane_t = typename rep_traits<std::remove_cvref_t<Rep>>::base_rep_type;
+
+} // namespace detail
+
 /// Concept is `true` if scaling `FromRep` by a `Scale` can be stored in a
 /// `ToRep` without loss of precision. Such capability is determined by the
-/// `rep_traits<ToRep>` specialization.
+/// `rep_traits<ToRep>` specialization. If `ToRep` is a `vector_rep`, each lane
+/// must also be scalable without loss of precision, as a scalar of the lane
+/// type would be.
 ///
 /// \tparam FromRep The original `rep` type holding the pre-scaled value.
 /// \tparam Scale The type of the scale factor (may be integral or floating
@@ -174,18 +299,20 @@ concept rep_lossily_castable_to = requires(FromRep from_value) {
 /// \tparam ToRep The resulting `rep` type that holds the post-scaled value.
 ///
 template <class FromRep, class ToRep, class Scale>
-concept rep_losslessly_scalable_to = requires(
-    FromRep from_value, detail::relaxed_scale_t<ToRep, Scale> scale_value) {
+concept rep_losslessly_scalable_to = requires {
   requires rep<FromRep>;
   requires rep<ToRep>;
-  requires rep_losslessly_castable_to<FromRep, ToRep>;
-  requires rep_losslessly_castable_to<decltype(from_value * scale_value),
-                                      ToRep>;
+  requires detail::value_losslessly_scalable_to<FromRep, ToRep, Scale>;
+  requires !detail::vector_rep<ToRep> ||
+               detail::value_losslessly_scalable_to<detail::lane_t<FromRep>,
+                                                    detail::lane_t<ToRep>,
+                                                    Scale>;
 };
 
 /// Concept is `true` if scaling `FromRep` by a `Scale` can be stored in a
 /// `ToRep` even if this would lose precision. Such capability is determined by
-/// the `rep_traits<ToRep>` specialization.
+/// the `rep_traits<ToRep>` specialization. If `ToRep` is a `vector_rep`, each
+/// lane must also be scalable, as a scalar of the lane type would be.
 ///
 /// \tparam FromRep The original `rep` type holding the pre-scaled value.
 /// \tparam Scale The type of the scale factor (may be integral or floating
@@ -193,12 +320,52 @@ concept rep_losslessly_scalable_to = requires(
 /// \tparam ToRep The resulting `rep` type that holds the post-scaled value.
 ///
 template <class FromRep, class ToRep, class Scale>
-concept rep_lossily_scalable_to = requires(
-    FromRep from_value, detail::relaxed_scale_t<ToRep, Scale> scale_value) {
+concept rep_lossily_scalable_to = requires {
   requires rep<FromRep>;
   requires rep<ToRep>;
-  requires rep_lossily_castable_to<FromRep, ToRep>;
-  requires rep_lossily_castable_to<decltype(from_value * scale_value), ToRep>;
+  requires detail::value_lossily_scalable_to<FromRep, ToRep, Scale>;
+  requires !detail::vector_rep<ToRep> ||
+               detail::value_lossily_scalable_to<detail::lane_t<FromRep>,
+                                                 detail::lane_t<ToRep>, Scale>;
+};
+
+/// Concept is `true` if `rep_traits<ToRep>` scales a `FromRep` by the unit
+/// conversion `Conversion` itself, and stores the result in a `ToRep` without
+/// loss of precision. Conversions to such a `ToRep` call
+/// `rep_traits<ToRep>::lossless_scale<Conversion>` instead of multiplying by
+/// the scale of the conversion.
+///
+/// \tparam FromRep The original `rep` type holding the pre-scaled value.
+/// \tparam ToRep The resulting `rep` type that holds the post-scaled value.
+/// \tparam Conversion The `detail::units_conversion` of the units.
+///
+template <class FromRep, class ToRep, class Conversion>
+concept rep_losslessly_scalable_by = requires(FromRep from_value) {
+  requires rep<FromRep>;
+  requires rep<ToRep>;
+  {
+    rep_traits<ToRep>::template lossless_scale<Conversion>(from_value)
+  } -> std::same_as<ToRep>;
+};
+
+/// Concept is `true` if `rep_traits<ToRep>` scales a `FromRep` by the unit
+/// conversion `Conversion` itself, and stores the result in a `ToRep` even if
+/// this would lose precision. Conversions to such a `ToRep` call
+/// `rep_traits<ToRep>::lossy_scale<Conversion, Rounding>` instead of
+/// multiplying by the scale of the conversion.
+///
+/// \tparam FromRep The original `rep` type holding the pre-scaled value.
+/// \tparam ToRep The resulting `rep` type that holds the post-scaled value.
+/// \tparam Conversion The `detail::units_conversion` of the units.
+///
+template <class FromRep, class ToRep, class Conversion>
+concept rep_lossily_scalable_by = requires(FromRep from_value) {
+  requires rep<FromRep>;
+  requires rep<ToRep>;
+  {
+    rep_traits<ToRep>::template lossy_scale<Conversion, rounding::truncate>(
+        from_value)
+  } -> std::same_as<ToRep>;
 };
 
 /// Concept is `true` if two types can be added together, and the resulting type
@@ -0,0 +1,105 @@
+#ifndef INCLUDED_MU_ROUNDING_HPP
+#define INCLUDED_MU_ROUNDING_HPP
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace mu {
+
+/// How `quantity_cast` rounds a scaled value that is stored in an integral
+/// representation.
+///
+enum class rounding {
+  /// Round toward zero. This is the default, and matches a `static_cast` from a
+  /// floating-point value to an integer.
+  truncate,
+
+  /// Round toward negative infinity.
+  floor,
+
+  /// Round toward positive infinity.
+  ceil,
+
+  /// Round to the nearest integer. Halfway values are rounded away from zero.
+  nearest,
+};
+
+namespace detail {
+
+/// Computes `value * Num / Den` in integer arithmetic, and rounds the exact
+/// result according to `Rounding`.
+///
+/// The value is split into `quotient * Den + remainder`, so only the remainder
+/// is multiplied before dividing. Since `Den` is a compile-time constant, the
+/// compiler replaces each division by a multiplication with its reciprocal.
+///
+/// \tparam Rounding How to round the result.
+/// \tparam Num Numerator of the scale. Must be positive if `T` is unsigned.
+/// \tparam Den Denominator of the scale. Must be positive, and `Num * Den` must
+/// not overflow a `std::intmax_t`.
+/// \tparam T Type of the value being scaled.
+/// \return The scaled value, as a `std::intmax_t` if `T` is signed, otherwise
+/// as a `std::uintmax_t`. It is not checked for overflow.
+///
+template <rounding Rounding, std::intmax_t Num, std::intmax_t Den,
+          std::integral T>
+constexpr auto scale_int(T value) {
+  using work_type = std::conditional_t<std::is_signed_v<T>, std::intmax_t,
+                                       std::uintmax_t>;
+  constexpr work_type num = static_cast<work_type>(Num);
+  constexpr work_type den = static_cast<work_type>(Den);
+
+  const work_type from = static_cast<work_type>(value);
+  const work_type part = (from % den) * num;
+  work_type result = (from / den) * num + part / den;
+
+  // The remainder of the exact result, scaled by `den`. It has the same sign as
+  // the exact result.
+  const work_type leftover = part % den;
+  if constexpr (Rounding == rounding::floor) {
+    if constexpr (std::is_signed_v<work_type>) {
+      result -= leftover < 0;
+    }
+  } else if constexpr (Rounding == rounding::ceil) {
+    result += leftover > 0;
+  } else if constexpr (Rounding == rounding::nearest) {
+    // Round away from zero if the leftover is at least half of `den`.
+    if constexpr (std::is_signed_v<work_type>) {
+      if (leftover < 0) {
+        result -= -leftover >= den + leftover;
+      } else {
+        result += leftover >= den - leftover;
+      }
+    } else {
+      result += leftover >= den - leftover;
+    }
+  }
+  return result;
+}
+
+/// Rounds a floating-point value to an integral `ToRep` according to
+/// `Rounding`. The value must be within the range of `ToRep`.
+///
+template <rounding Rounding, std::integral ToRep, std::floating_point Float>
+constexpr ToRep round_float(Float value) {
+  ToRep result = static_cast<ToRep>(value);
+  if constexpr (Rounding == rounding::floor) {
+    result -= value < result;
+  } else if constexpr (Rounding == rounding::ceil) {
+    result += value > result;
+  } else if constexpr (Rounding == rounding::nearest) {
+    const Float difference = value - result;
+    if (difference >= Float{0.5}) {
+      ++result;
+    } else if (difference <= Float{-0.5}) {
+      --result;
+    }
+  }
+  return result;
+}
+
+} // namespace detail
+
+} // namespace mu
+
+#endif
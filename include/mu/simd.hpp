@@ -0,0 +1,252 @@
+#ifndef INCLUDED_MU_SIMD_HPP
+#define INCLUDED_MU_SIMD_HPP
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <mu/rep.hpp>
+#include <type_traits>
+#include <utility>
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+// Representations that hold several values in SIMD lanes: the vector types of
+// the GCC and Clang vector extensions, where the compiler supports them, and
+// `std::experimental::simd`, where the standard library provides it.
+//
+// Each lane is measured in the units of the quantity, so a
+// `quantity<std::experimental::native_simd<float>, meter>` is several lengths
+// in meters. Arithmetic is lane-wise, and conversions to other units multiply
+// every lane by the same compile-time scale, which is broadcast as a scalar of
+// the lane type. Scalar values are broadcast to every lane, so a quantity of a
+// scalar converts to a quantity of a vector of the same units.
+//
+// Lanes are converted only when the conversion of each lane is defined without
+// rounding: between vectors with the same number of lanes, and never from
+// floating-point to integral lanes. Integral lanes are only scaled by integers.
+// A conversion is lossless only if it is lossless for a scalar of the lane
+// type, so a scale that does not fit in a lane is only applied explicitly.
+// Comparison operators of quantities return `bool`, so they cannot be used
+// for vector representations; compare the values to get a mask of lanes.
+//
+// Vectors wider than the registers of the target, such as 32-byte vectors
+// without AVX, are passed to functions in memory, and GCC warns that this
+// changes the ABI (-Wpsabi).
+//
+// This header is not included by `mu/mu.hpp`, because it depends on compiler
+// extensions and on an experimental standard library header.
+
+namespace mu {
+
+namespace detail {
+
+/// Concept is `true` if a `From` lane converts to a `To` lane without
+/// rounding. Floating-point values would be rounded to integral lanes, so they
+/// are never converted to them.
+///
+template <class From, class To>
+concept lane_lossily_castable_to = requires {
+  requires rep_lossily_castable_to<From, To>;
+  requires !(std::floating_point<From> && std::integral<To>);
+};
+
+/// Concept is `true` if the integer scale of `Conversion` does not fit in a
+/// `Lane`. Vectors are only multiplied by scalars of their lane type, so such
+/// conversions are scaled by `rep_traits<Vector>::lossy_scale`.
+///
+template <class Conversion, class Lane>
+concept int_scale_exceeds_lane = requires {
+  requires std::integral<Lane>;
+  requires std::integral<typename Conversion::type>;
+  requires !brace_convertible_to<typename Conversion::type, Lane>;
+};
+
+} // namespace detail
+
+#if defined(__GNUC__)
+
+namespace detail {
+
+/// The vector extension type of `Size` bytes of `Lane` values. The type is
+/// declared in a struct because attributes of alias templates are ignored.
+template <class Lane, std::size_t Size> struct vector_extension {
+  typedef Lane type __attribute__((vector_size(Size)));
+};
+
+/// Type of the lanes of a type with a subscript operator.
+template <class T, class = void> struct subscript {};
+
+template <class T>
+struct subscript<T, std::void_t<decltype(std::declval<T &>()[0])>> {
+  using type = std::remove_cvref_t<decltype(std::declval<T &>()[0])>;
+};
+
+template <class T> using subscript_t = typename subscript<T>::type;
+
+/// Returns `true` if `T` is a vector type of the GCC and Clang vector
+/// extensions, whose lanes are `base_rep` types.
+///
+/// This is a function, rather than a requires-expression, because GCC 12 does
+/// not match partial specializations constrained by the equivalent concept.
+template <class T> constexpr bool is_vector_extension() {
+  if constexpr (std::is_class_v<T> || std::is_array_v<T> ||
+                std::is_pointer_v<T>) {
+    return false;
+  } else if constexpr (requires { typename subscript<T>::type; }) {
+    using lane = subscript_t<T>;
+    if constexpr (base_rep<lane> && sizeof(T) > sizeof(lane) &&
+                  std::has_single_bit(sizeof(T))) {
+      return std::is_same_v<T,
+                            typename vector_extension<lane, sizeof(T)>::type>;
+    } else {
+      return false;
+    }
+  } else {
+    return false;
+  }
+}
+
+/// Concept matches the vector types of the GCC and Clang vector extensions
+/// whose lanes are `base_rep` types.
+///
+template <class T>
+concept vector_extension_rep = is_vector_extension<T>();
+
+} // namespace detail
+
+/// A vector extension type of `Lanes` values of type `Lane`. For example,
+/// `vector_extension_t<float, 8>` is eight `float` lanes in a 32-byte vector.
+///
+/// \tparam Lane The type of each lane. Must satisfy `base_rep`.
+/// \tparam Lanes The number of lanes. The size of the vector must be a power
+/// of two.
+///
+template <base_rep Lane, std::size_t Lanes>
+requires(std::has_single_bit(Lanes * sizeof(Lane)))
+using vector_extension_t =
+    typename detail::vector_extension<Lane, Lanes * sizeof(Lane)>::type;
+
+/// Specialization of `rep_traits` for the vector types of the GCC and Clang
+/// vector extensions.
+///
+template <detail::vector_extension_rep Vector> struct rep_traits<Vector> {
+  using base_rep_type = detail::subscript_t<Vector>;
+
+  /// Number of lanes in the vector.
+  constexpr static std::size_t lane_count =
+      sizeof(Vector) / sizeof(base_rep_type);
+
+  constexpr static Vector lossless_cast(Vector from_value) {
+    return from_value;
+  }
+
+  template <base_rep FromRep>
+  requires rep_losslessly_castable_to<FromRep, base_rep_type>
+  constexpr static Vector lossless_cast(FromRep from_value) {
+    return Vector{} + rep_traits<base_rep_type>::lossless_cast(from_value);
+  }
+
+  template <detail::vector_extension_rep FromVector>
+  requires(!std::same_as<FromVector, Vector> &&
+           rep_traits<FromVector>::lane_count == lane_count &&
+           rep_losslessly_castable_to<detail::subscript_t<FromVector>,
+                                      base_rep_type>)
+  constexpr static Vector lossless_cast(FromVector from_value) {
+    return __builtin_convertvector(from_value, Vector);
+  }
+
+  constexpr static Vector lossy_cast(Vector from_value) { return from_value; }
+
+  template <base_rep FromRep>
+  requires detail::lane_lossily_castable_to<FromRep, base_rep_type>
+  constexpr static Vector lossy_cast(FromRep from_value) {
+    return Vector{} + rep_traits<base_rep_type>::lossy_cast(from_value);
+  }
+
+  template <detail::vector_extension_rep FromVector>
+  requires(!std::same_as<FromVector, Vector> &&
+           rep_traits<FromVector>::lane_count == lane_count &&
+           detail::lane_lossily_castable_to<detail::subscript_t<FromVector>,
+                                            base_rep_type>)
+  constexpr static Vector lossy_cast(FromVector from_value) {
+    return __builtin_convertvector(from_value, Vector);
+  }
+
+  /// Scales by an integer that does not fit in a lane. A scalar lane keeps the
+  /// low bits of the scaled value, and so does multiplying by the low bits of
+  /// the scale.
+  template <class Conversion, rounding Rounding, class FromRep>
+  requires detail::int_scale_exceeds_lane<Conversion, base_rep_type> &&
+           rep_lossily_castable_to<FromRep, Vector>
+  constexpr static Vector lossy_scale(FromRep from_value) {
+    return lossy_cast(from_value) *
+           static_cast<base_rep_type>(Conversion::value);
+  }
+};
+
+#endif
+
+#if __has_include(<experimental/simd>)
+
+/// Specialization of `rep_traits` for `std::experimental::simd`. The casts are
+/// not `constexpr`, because the operations of `simd` are not.
+///
+template <base_rep Lane, class Abi>
+struct rep_traits<std::experimental::simd<Lane, Abi>> {
+  using base_rep_type = Lane;
+
+  /// Number of lanes in the vector.
+  constexpr static std::size_t lane_count =
+      std::experimental::simd_size_v<Lane, Abi>;
+
+  using simd_type = std::experimental::simd<Lane, Abi>;
+
+  static simd_type lossless_cast(simd_type from_value) { return from_value; }
+
+  template <base_rep FromRep>
+  requires rep_losslessly_castable_to<FromRep, Lane>
+  static simd_type lossless_cast(FromRep from_value) {
+    return simd_type{rep_traits<Lane>::lossless_cast(from_value)};
+  }
+
+  template <base_rep FromLane, class FromAbi>
+  requires(!std::same_as<FromLane, Lane> &&
+           std::experimental::simd_size_v<FromLane, FromAbi> == lane_count &&
+           rep_losslessly_castable_to<FromLane, Lane>)
+  static simd_type
+  lossless_cast(std::experimental::simd<FromLane, FromAbi> from_value) {
+    return std::experimental::static_simd_cast<simd_type>(from_value);
+  }
+
+  static simd_type lossy_cast(simd_type from_value) { return from_value; }
+
+  template <base_rep FromRep>
+  requires detail::lane_lossily_castable_to<FromRep, Lane>
+  static simd_type lossy_cast(FromRep from_value) {
+    return simd_type{rep_traits<Lane>::lossy_cast(from_value)};
+  }
+
+  template <base_rep FromLane, class FromAbi>
+  requires(!std::same_as<FromLane, Lane> &&
+           std::experimental::simd_size_v<FromLane, FromAbi> == lane_count &&
+           detail::lane_lossily_castable_to<FromLane, Lane>)
+  static simd_type
+  lossy_cast(std::experimental::simd<FromLane, FromAbi> from_value) {
+    return std::experimental::static_simd_cast<simd_type>(from_value);
+  }
+
+  /// Scales by an integer that does not fit in a lane, as for vector
+  /// extension types.
+  template <class Conversion, rounding Rounding, class FromRep>
+  requires detail::int_scale_exceeds_lane<Conversion, Lane> &&
+           rep_lossily_castable_to<FromRep, simd_type>
+  static simd_type lossy_scale(FromRep from_value) {
+    return lossy_cast(from_value) * static_cast<Lane>(Conversion::value);
+  }
+};
+
+#endif
+
+} // namespace mu
+
+#endif
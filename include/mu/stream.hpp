@@ -1,43 +1,341 @@
 #ifndef INCLUDED_MU_OSTREAM_HPP
 #define INCLUDED_MU_OSTREAM_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <locale>
+#include <mu/detail/unit_label.hpp>
 #include <mu/detail/unit_string.hpp>
 #include <mu/quantity.hpp>
 #include <mu/units.hpp>
 #include <ostream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 namespace mu {
 
 namespace detail {
 
-/// Holds indices from the "internal extensible array" reserved for holding
-/// format options.
+/// Returns the next unused `units_index`.
 ///
-/// Functions should only obtain instances of this struct from the
-/// `get_xalloc_indices` method. They should never construct them directly.
+inline std::size_t next_units_index() {
+  static std::atomic<std::size_t> next{0};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Returns a small integer that uniquely identifies `Units` within the running
+/// program. Indices are assigned densely, in order of first use, so they can be
+/// used to index per-stream caches.
 ///
-struct xalloc_indices {
-  int label_type;
-  int mult_sep;
-  int superscript_exponents;
+template <units Units> std::size_t units_index() {
+  static const std::size_t index = next_units_index();
+  return index;
+}
+
+/// The format state of one stream, stored in the stream's "internal extensible
+/// array" as a single pword-owned object.
+///
+/// The object is created by the first manipulator inserted into a stream, and
+/// it is owned by the stream from then on: `std::ios_base::copyfmt` clones it,
+/// and destroying the stream deletes it. Streams that were never manipulated
+/// have no state, and format quantities with a default-constructed
+/// `format_options`.
+///
+/// Besides the decoded options, the state caches the label of each `Units` type
+/// inserted with a non-default mult separator, so repeated insertions write
+/// the whole label with a single call to the stream buffer. The cache is
+/// cleared whenever an option changes.
+///
+/// Thread-safety: the state is only ever accessed through its stream, so it has
+/// the same guarantees as the stream itself. Streams owned by a single thread
+/// need no synchronization. A stream shared between threads must already be
+/// externally synchronized for insertions, and that also covers its state. The
+/// only data shared between streams are the constant label tables and the
+/// index counters, which are initialized thread-safely.
+///
+class stream_state {
+public:
+  /// Returns the state of \p ios, or `nullptr` if it has none.
+  static stream_state *find(std::ios_base &ios) {
+    return static_cast<stream_state *>(ios.pword(xalloc_index()));
+  }
+
+  /// Returns the state of \p ios, creating it if it has none.
+  static stream_state &get(std::ios_base &ios) {
+    int index = xalloc_index();
+    void *&pword = ios.pword(index);
+    if (!pword) {
+      pword = new stream_state;
+      ios.register_callback(&stream_state::callback, index);
+    }
+    return *static_cast<stream_state *>(pword);
+  }
+
+  /// Returns the format options. The `mult_sep` member points into this state,
+  /// and remains valid until the separator changes.
+  format_options options() const {
+    return unit_label_options(label_index_, mult_sep_.c_str());
+  }
+
+  void set_options(const format_options &opts) {
+    label_index_ = unit_label_index(opts);
+    mult_sep_ = opts.mult_sep;
+    labels_.clear();
+  }
+
+  void set_labels(format_options::label_type ltype) {
+    auto opts = options();
+    opts.labels = ltype;
+    label_index_ = unit_label_index(opts);
+    labels_.clear();
+  }
+
+  void set_superscript_exponents(bool superscript_exponents) {
+    auto opts = options();
+    opts.superscript_exponents = superscript_exponents;
+    label_index_ = unit_label_index(opts);
+    labels_.clear();
+  }
+
+  void set_simplified(bool simplified) {
+    auto opts = options();
+    opts.simplified = simplified;
+    label_index_ = unit_label_index(opts);
+    labels_.clear();
+  }
+
+  /// Sets the mult separator. The separator is copied into this state.
+  void set_mult_sep(const char *mult_sep) {
+    mult_sep_ = mult_sep;
+    labels_.clear();
+  }
+
+  /// Writes the label of `Units` according to this state.
+  ///
+  /// \param write Callable invoked as `write(const char *, std::size_t)`.
+  ///
+  template <units Units, class Writer> void write_label(Writer &&write) {
+    const unit_label &label = unit_label_table<Units>::labels[label_index_];
+    if (!label.has_mult_sep || mult_sep_ == format_options{}.mult_sep) {
+      write_unit_label(label, mult_sep_, write);
+      return;
+    }
+    std::size_t index = units_index<Units>();
+    if (index >= labels_.size()) {
+      labels_.resize(index + 1);
+    }
+    std::string &cached = labels_[index];
+    if (cached.empty()) {
+      write_unit_label(label, mult_sep_,
+                       [&](const char *data, std::size_t size) {
+                         cached.append(data, size);
+                       });
+    }
+    write(cached.data(), cached.size());
+  }
+
+private:
+  stream_state() = default;
+  stream_state(const stream_state &) = default;
+
+  /// The single index reserved from the "internal extensible array".
+  static int xalloc_index() {
+    static const int index = std::ios_base::xalloc();
+    return index;
+  }
+
+  /// Clones the state when the stream's format is copied, and deletes it when
+  /// the stream is destroyed.
+  static void callback(std::ios_base::event event, std::ios_base &ios,
+                       int index) {
+    void *&pword = ios.pword(index);
+    if (!pword) {
+      return;
+    }
+    if (event == std::ios_base::erase_event) {
+      delete static_cast<stream_state *>(pword);
+      pword = nullptr;
+    } else if (event == std::ios_base::copyfmt_event) {
+      // The pword still points to the source stream's state.
+      try {
+        pword = new stream_state(*static_cast<stream_state *>(pword));
+      } catch (...) {
+        pword = nullptr;
+      }
+    }
+  }
+
+  /// Index of the `unit_label_table` entry selected by the options.
+  std::size_t label_index_ = 0;
+
+  /// The mult separator, owned by this state.
+  std::string mult_sep_ = format_options{}.mult_sep;
+
+  /// Cached labels, indexed by `units_index`. Empty strings are not cached.
+  std::vector<std::string> labels_;
 };
 
-/// Returns indices allocated from the "internal extensible array".
-///
-/// The indices are initialized statically (only once) on the first invocation.
-/// Functions that need to refer to the allocated indices should only do so by
-/// calling this function.
-///
-inline xalloc_indices get_xalloc_indices() {
-  static int label_type = std::ios::xalloc();
-  static int mult_sep = std::ios::xalloc();
-  static int superscript_exponents = std::ios::xalloc();
-  xalloc_indices indices;
-  indices.label_type = label_type;
-  indices.mult_sep = mult_sep;
-  indices.superscript_exponents = superscript_exponents;
-  return indices;
+/// Writes the label of `Units` according to the format state of \p ios.
+///
+/// \param write Callable invoked as `write(const char *, std::size_t)`.
+///
+template <units Units, class Writer>
+void write_stream_label(std::ios_base &ios, Writer &&write) {
+  if (auto *state = stream_state::find(ios)) {
+    state->write_label<Units>(write);
+  } else {
+    write_unit_label(unit_label_table<Units>::labels[0],
+                     format_options{}.mult_sep, write);
+  }
 }
 
+/// Concept matches representations that a stream inserts as numbers. Character
+/// types are excluded, because streams insert them as characters.
+///
+template <class Rep>
+concept stream_number_rep =
+    std::floating_point<Rep> ||
+    (std::integral<Rep> && !std::same_as<Rep, bool> &&
+     !std::same_as<Rep, char> && !std::same_as<Rep, signed char> &&
+     !std::same_as<Rep, unsigned char> && !std::same_as<Rep, wchar_t> &&
+     !std::same_as<Rep, char8_t> && !std::same_as<Rep, char16_t> &&
+     !std::same_as<Rep, char32_t>);
+
+/// Describes how to reproduce a stream's number formatting with
+/// `std::to_chars`.
+///
+/// Only the common cases are supported: the classic locale, no field width,
+/// and none of `showpos`, `showpoint`, `showbase` or `uppercase`. Integers must
+/// be formatted in decimal, and floating-point numbers must not be formatted as
+/// `hexfloat`. In all other cases, `supported` is false and values must be
+/// inserted with `<<` instead.
+///
+template <class Rep> struct to_chars_format {
+  /// True if `std::to_chars` reproduces the stream's formatting.
+  bool supported = false;
+
+  /// Format of floating-point numbers.
+  std::chars_format fmt = std::chars_format::general;
+
+  /// Precision of floating-point numbers.
+  int precision = 6;
+
+  explicit to_chars_format(const std::ios_base &ios) {
+    if constexpr (stream_number_rep<Rep>) {
+      constexpr auto unsupported_flags =
+          std::ios_base::showpos | std::ios_base::showpoint |
+          std::ios_base::showbase | std::ios_base::uppercase;
+      if (ios.width() != 0 || (ios.flags() & unsupported_flags) ||
+          ios.getloc() != std::locale::classic()) {
+        return;
+      }
+      if constexpr (std::floating_point<Rep>) {
+        auto floatfield = ios.flags() & std::ios_base::floatfield;
+        if (floatfield == std::ios_base::fixed) {
+          fmt = std::chars_format::fixed;
+        } else if (floatfield == std::ios_base::scientific) {
+          fmt = std::chars_format::scientific;
+        } else if (floatfield != std::ios_base::fmtflags{}) {
+          return;
+        }
+        precision = static_cast<int>(ios.precision());
+      } else {
+        auto basefield = ios.flags() & std::ios_base::basefield;
+        if (basefield != std::ios_base::dec &&
+            basefield != std::ios_base::fmtflags{}) {
+          return;
+        }
+      }
+      supported = true;
+    }
+  }
+
+  /// Formats \p value into `[first, last)`. Only valid if `supported`.
+  std::to_chars_result to_chars(char *first, char *last,
+                                const Rep &value) const {
+    if constexpr (std::floating_point<Rep>) {
+      return std::to_chars(first, last, value, fmt, precision);
+    } else {
+      return std::to_chars(first, last, value);
+    }
+  }
+};
+
+/// Writes to a stream through a fixed-size buffer, so that many small pieces
+/// of output reach the stream buffer in a few large `sputn` calls.
+///
+/// The caller must hold a sentry for the stream while the writer is in use,
+/// and must call `flush` when done.
+///
+class batch_writer {
+public:
+  explicit batch_writer(std::ostream &stream)
+      : stream_{stream}, buf_{stream.rdbuf()} {}
+
+  batch_writer(const batch_writer &) = delete;
+  batch_writer &operator=(const batch_writer &) = delete;
+
+  /// Writes raw characters.
+  void write(const char *data, std::size_t size) {
+    if (size > static_cast<std::size_t>(end() - pos_)) {
+      flush();
+      if (size > buffer_.size()) {
+        put(data, size);
+        return;
+      }
+    }
+    pos_ = std::copy_n(data, size, pos_);
+  }
+
+  /// Writes a value exactly as `stream << value` would.
+  template <class Rep>
+  void write_value(const Rep &value, const to_chars_format<Rep> &fmt) {
+    if (fmt.supported) {
+      auto result = fmt.to_chars(pos_, end(), value);
+      if (result.ec != std::errc{} && pos_ != buffer_.data()) {
+        flush();
+        result = fmt.to_chars(pos_, end(), value);
+      }
+      if (result.ec == std::errc{}) {
+        pos_ = result.ptr;
+        return;
+      }
+    }
+    flush();
+    stream_ << value;
+  }
+
+  /// Passes all buffered characters to the stream buffer. Sets `badbit` on
+  /// the stream if any write failed.
+  void flush() {
+    put(buffer_.data(), static_cast<std::size_t>(pos_ - buffer_.data()));
+    pos_ = buffer_.data();
+    if (!ok_) {
+      stream_.setstate(std::ios_base::badbit);
+    }
+  }
+
+private:
+  char *end() { return buffer_.data() + buffer_.size(); }
+
+  void put(const char *data, std::size_t size) {
+    auto count = static_cast<std::streamsize>(size);
+    ok_ = ok_ && buf_->sputn(data, count) == count;
+  }
+
+  std::ostream &stream_;
+  std::streambuf *buf_;
+  std::array<char, 512> buffer_;
+  char *pos_ = buffer_.data();
+  bool ok_ = true;
+};
+
 } // namespace detail
 
 namespace stream {
@@ -53,12 +351,9 @@ namespace stream {
 ///   `std::cout << mu::stream::reset << my_quantity;`
 ///
 inline std::ostream &reset(std::ostream &stream) {
-  static auto indices = detail::get_xalloc_indices();
-  static format_options default_format;
-  stream.iword(indices.label_type) = static_cast<long>(default_format.labels);
-  stream.pword(indices.mult_sep) = const_cast<char *>(default_format.mult_sep);
-  stream.iword(indices.superscript_exponents) =
-      static_cast<long>(default_format.superscript_exponents);
+  if (auto *state = detail::stream_state::find(stream)) {
+    state->set_options(format_options{});
+  }
   return stream;
 }
 
@@ -80,11 +375,7 @@ public:
   explicit format(const format_options opts) : opts_{opts} {}
 
   friend std::ostream &operator<<(std::ostream &stream, format manip) {
-    static auto indices = detail::get_xalloc_indices();
-    stream.iword(indices.label_type) = static_cast<long>(manip.opts_.labels);
-    stream.pword(indices.mult_sep) = const_cast<char *>(manip.opts_.mult_sep);
-    stream.iword(indices.superscript_exponents) =
-        static_cast<long>(manip.opts_.superscript_exponents);
+    detail::stream_state::get(stream).set_options(manip.opts_);
     return stream;
   }
 
@@ -110,8 +401,7 @@ public:
   explicit labels(format_options::label_type ltype) : ltype_{ltype} {}
 
   friend std::ostream &operator<<(std::ostream &stream, labels manip) {
-    static auto indices = detail::get_xalloc_indices();
-    stream.iword(indices.label_type) = static_cast<long>(manip.ltype_);
+    detail::stream_state::get(stream).set_labels(manip.ltype_);
     return stream;
   }
 
@@ -127,9 +417,8 @@ private:
 ///   `std::cout << mu::stream::names << my_quantity;`
 ///
 inline std::ostream &names(std::ostream &stream) {
-  static auto indices = detail::get_xalloc_indices();
-  stream.iword(indices.label_type) =
-      static_cast<long>(format_options::label_type::names);
+  detail::stream_state::get(stream).set_labels(
+      format_options::label_type::names);
   return stream;
 }
 
@@ -141,9 +430,8 @@ inline std::ostream &names(std::ostream &stream) {
 ///   `std::cout << mu::stream::symbols << my_quantity;`
 ///
 inline std::ostream &symbols(std::ostream &stream) {
-  static auto indices = detail::get_xalloc_indices();
-  stream.iword(indices.label_type) =
-      static_cast<long>(format_options::label_type::symbols);
+  detail::stream_state::get(stream).set_labels(
+      format_options::label_type::symbols);
   return stream;
 }
 
@@ -162,8 +450,7 @@ public:
   explicit mult_sep(const char *sep) : sep_{sep} {}
 
   friend std::ostream &operator<<(std::ostream &stream, mult_sep manip) {
-    static auto indices = detail::get_xalloc_indices();
-    stream.pword(indices.mult_sep) = const_cast<char *>(manip.sep_);
+    detail::stream_state::get(stream).set_mult_sep(manip.sep_);
     return stream;
   }
 
@@ -179,8 +466,7 @@ private:
 ///   `std::cout << mu::stream::superscript_exponents << my_quantity;`
 ///
 inline std::ostream &superscript_exponents(std::ostream &stream) {
-  static auto indices = detail::get_xalloc_indices();
-  stream.iword(indices.superscript_exponents) = static_cast<long>(true);
+  detail::stream_state::get(stream).set_superscript_exponents(true);
   return stream;
 }
 
@@ -193,8 +479,118 @@ inline std::ostream &superscript_exponents(std::ostream &stream) {
 ///   `std::cout << mu::stream::ascii_exponents << my_quantity;`
 ///
 inline std::ostream &ascii_exponents(std::ostream &stream) {
-  static auto indices = detail::get_xalloc_indices();
-  stream.iword(indices.superscript_exponents) = static_cast<long>(false);
+  detail::stream_state::get(stream).set_superscript_exponents(false);
+  return stream;
+}
+
+/// Sets unit expressions to be displayed in simplified form. See
+/// `format_options::simplified`.
+///
+/// This is a stream manipulator with no arguments. Clients use this method by
+/// inserting a function pointer into a stream. For example:
+///
+///   `std::cout << mu::stream::simplified << my_quantity;`
+///
+inline std::ostream &simplified(std::ostream &stream) {
+  detail::stream_state::get(stream).set_simplified(true);
+  return stream;
+}
+
+/// Sets unit expressions to be displayed as written.
+///
+/// This is a stream manipulator with no arguments. Clients use this method by
+/// inserting a function pointer into a stream. For example:
+///
+///   `std::cout << mu::stream::as_written << my_quantity;`
+///
+inline std::ostream &as_written(std::ostream &stream) {
+  detail::stream_state::get(stream).set_simplified(false);
+  return stream;
+}
+
+/// Writes a range of quantities, followed by their unit label only once. For
+/// example, a range of three speeds is written as
+/// `1.5, 2, 2.5 meter * second^-1`.
+///
+/// The label is formatted according to the stream's format options, just like
+/// a quantity inserted with `<<`, and values are formatted according to the
+/// stream's flags. When the flags permit it, values are formatted with
+/// `std::to_chars` and passed to the stream buffer in large batches, instead of
+/// being inserted one at a time.
+///
+/// \param stream Write to this stream.
+/// \param range A range of `mu::quantity` elements.
+/// \param sep Written between consecutive values.
+/// \return The stream.
+///
+template <std::ranges::input_range Range>
+requires is_quantity_v<std::ranges::range_value_t<Range>>
+std::ostream &write_range(std::ostream &stream, Range &&range,
+                          std::string_view sep = ", ") {
+  using quantity_type = std::ranges::range_value_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  std::ostream::sentry sentry{stream};
+  if (sentry) {
+    detail::to_chars_format<rep_type> fmt{stream};
+    detail::batch_writer out{stream};
+    bool first = true;
+    for (const quantity_type &q : range) {
+      if (!first) {
+        out.write(sep.data(), sep.size());
+      }
+      first = false;
+      out.write_value(q.value(), fmt);
+    }
+    out.write(" ", 1);
+    detail::write_stream_label<typename quantity_type::units_type>(
+        stream, [&](const char *data, std::size_t size) {
+          out.write(data, size);
+        });
+    out.flush();
+  }
+  return stream;
+}
+
+/// Writes a range of quantities as a column of text: a header line with the
+/// column \p name and the unit label in brackets, followed by one line per
+/// value. For example:
+///
+///   ```
+///   speed [meter * second^-1]
+///   1.5
+///   2
+///   ```
+///
+/// Values and the label are formatted as in `write_range`.
+///
+/// \param stream Write to this stream.
+/// \param name Name of the column.
+/// \param range A range of `mu::quantity` elements.
+/// \return The stream.
+///
+template <std::ranges::input_range Range>
+requires is_quantity_v<std::ranges::range_value_t<Range>>
+std::ostream &write_column(std::ostream &stream, std::string_view name,
+                           Range &&range) {
+  using quantity_type = std::ranges::range_value_t<Range>;
+  using rep_type = typename quantity_type::rep_type;
+  std::ostream::sentry sentry{stream};
+  if (sentry) {
+    detail::to_chars_format<rep_type> fmt{stream};
+    detail::batch_writer out{stream};
+    out.write(name.data(), name.size());
+    out.write(" [", 2);
+    detail::write_stream_label<typename quantity_type::units_type>(
+        stream, [&](const char *data, std::size_t size) {
+          out.write(data, size);
+        });
+    out.write("]\n", 2);
+    for (const quantity_type &q : range) {
+      out.write_value(q.value(), fmt);
+      out.write("\n", 1);
+    }
+    out.flush();
+  }
   return stream;
 }
 
@@ -207,7 +603,11 @@ inline std::ostream &ascii_exponents(std::ostream &stream) {
 ///
 /// The units are formatted according to a `mu::format_options` object held in
 /// the stream. These options can be controlled by various stream manipulators
-/// defined by the library.
+/// defined by the library, and held in a `detail::stream_state`. The label
+/// itself is precomputed once per `Units` type (see
+/// `detail::unit_label_table`), so inserting a quantity only allocates the
+/// first time a `Units` type is inserted with a custom mult separator, when its
+/// label is cached.
 ///
 /// \tparam Rep Representation of the quantity.
 /// \tparam Units Units of the quantity.
@@ -218,22 +618,21 @@ template <rep Rep, units Units>
 std::ostream &operator<<(std::ostream &stream, const quantity<Rep, Units> &q) {
   stream << q.value();
 
-  auto indices = detail::get_xalloc_indices();
-  format_options opts;
-  long iword_label_type = stream.iword(indices.label_type);
-  void *pword_mult_sep = stream.pword(indices.mult_sep);
-  long iword_superscript_exponents =
-      stream.iword(indices.superscript_exponents);
-  if (iword_label_type) {
-    opts.labels = static_cast<format_options::label_type>(iword_label_type);
-  }
-  if (pword_mult_sep) {
-    opts.mult_sep = reinterpret_cast<const char *>(pword_mult_sep);
-  }
-  if (iword_superscript_exponents) {
-    opts.superscript_exponents = true;
+  // Write the label straight to the stream buffer, either from the compile-time
+  // table or from the stream's cache of labels with a custom mult separator.
+  std::ostream::sentry sentry{stream};
+  if (sentry) {
+    std::streambuf *buf = stream.rdbuf();
+    bool ok = buf->sputc(' ') != std::ostream::traits_type::eof();
+    auto write = [&](const char *data, std::size_t size) {
+      auto count = static_cast<std::streamsize>(size);
+      ok = ok && buf->sputn(data, count) == count;
+    };
+    detail::write_stream_label<Units>(stream, write);
+    if (!ok) {
+      stream.setstate(std::ios_base::badbit);
+    }
   }
-  stream << ' ' << to_string<Units>(opts);
 
   return stream;
 }
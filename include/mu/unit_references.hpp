@@ -24,7 +24,8 @@
 /// \p LhsUnits and \p RhsUnits.
 ///
 template <mu::units LhsUnits, mu::units RhsUnits>
-constexpr mu::mult<LhsUnits, RhsUnits> operator*(LhsUnits &&, RhsUnits &&) {
+constexpr mu::detail::product_units_t<LhsUnits, RhsUnits>
+operator*(LhsUnits &&, RhsUnits &&) {
   return {};
 }
 
@@ -39,8 +40,8 @@ constexpr mu::mult<LhsUnits, RhsUnits> operator*(LhsUnits &&, RhsUnits &&) {
 /// \p LhsUnits and \p RhsUnits.
 ///
 template <mu::units LhsUnits, mu::units RhsUnits>
-constexpr mu::mult<LhsUnits, mu::pow<RhsUnits, -1>> operator/(LhsUnits &&,
-                                                              RhsUnits &&) {
+constexpr mu::detail::quotient_units_t<LhsUnits, RhsUnits>
+operator/(LhsUnits &&, RhsUnits &&) {
   return {};
 }
 
@@ -87,9 +88,10 @@ namespace mu {
 /// whose units are the product of the input quantity and the unit reference.
 ///
 template <rep LhsRep, units LhsUnits, units RhsUnits>
-constexpr quantity<LhsRep, mult<LhsUnits, RhsUnits>>
+constexpr quantity<LhsRep, detail::product_units_t<LhsUnits, RhsUnits>>
 operator*(const quantity<LhsRep, LhsUnits> &q, RhsUnits &&) {
-  return quantity<LhsRep, mult<LhsUnits, RhsUnits>>{q.value()};
+  return quantity<LhsRep, detail::product_units_t<LhsUnits, RhsUnits>>{
+      q.value()};
 }
 
 /// Multiplies a quantity rvalue by a unit reference, producing a new quantity
@@ -106,9 +108,10 @@ operator*(const quantity<LhsRep, LhsUnits> &q, RhsUnits &&) {
 /// The input quantity's value is moved into the new quantity.
 ///
 template <rep LhsRep, units LhsUnits, units RhsUnits>
-constexpr quantity<LhsRep, mult<LhsUnits, RhsUnits>>
+constexpr quantity<LhsRep, detail::product_units_t<LhsUnits, RhsUnits>>
 operator*(quantity<LhsRep, LhsUnits> &&q, RhsUnits &&) {
-  return quantity<LhsRep, mult<LhsUnits, RhsUnits>>{std::move(q).value()};
+  return quantity<LhsRep, detail::product_units_t<LhsUnits, RhsUnits>>{
+      std::move(q).value()};
 }
 
 /// Multiplies a unit reference by a quantity lvalue, producing a new quantity
@@ -124,9 +127,10 @@ operator*(quantity<LhsRep, LhsUnits> &&q, RhsUnits &&) {
 /// whose units are the product of the input quantity and the unit reference.
 ///
 template <units LhsUnits, rep RhsRep, units RhsUnits>
-constexpr quantity<RhsRep, mult<LhsUnits, RhsUnits>>
+constexpr quantity<RhsRep, detail::product_units_t<LhsUnits, RhsUnits>>
 operator*(LhsUnits &&, const quantity<RhsRep, RhsUnits> &q) {
-  return quantity<RhsRep, mult<LhsUnits, RhsUnits>>{q.value()};
+  return quantity<RhsRep, detail::product_units_t<LhsUnits, RhsUnits>>{
+      q.value()};
 }
 
 /// Multiplies a unit reference by a quantity rvalue, producing a new quantity
@@ -143,9 +147,10 @@ operator*(LhsUnits &&, const quantity<RhsRep, RhsUnits> &q) {
 /// The input quantity's value is moved into the new quantity.
 ///
 template <units LhsUnits, rep RhsRep, units RhsUnits>
-constexpr quantity<RhsRep, mult<LhsUnits, RhsUnits>>
+constexpr quantity<RhsRep, detail::product_units_t<LhsUnits, RhsUnits>>
 operator*(LhsUnits &&, quantity<RhsRep, RhsUnits> &&q) {
-  return quantity<RhsRep, mult<LhsUnits, RhsUnits>>{std::move(q).value()};
+  return quantity<RhsRep, detail::product_units_t<LhsUnits, RhsUnits>>{
+      std::move(q).value()};
 }
 
 /// Divides a quantity lvalue by a unit reference, producing a new quantity.
@@ -160,9 +165,10 @@ operator*(LhsUnits &&, quantity<RhsRep, RhsUnits> &&q) {
 /// whose units are the quotient of the input quantity and the unit reference.
 ///
 template <rep LhsRep, units LhsUnits, units RhsUnits>
-constexpr quantity<LhsRep, mult<LhsUnits, pow<RhsUnits, -1>>>
+constexpr quantity<LhsRep, detail::quotient_units_t<LhsUnits, RhsUnits>>
 operator/(const quantity<LhsRep, LhsUnits> &q, RhsUnits &&) {
-  return quantity<LhsRep, mult<LhsUnits, pow<RhsUnits, -1>>>{q.value()};
+  return quantity<LhsRep, detail::quotient_units_t<LhsUnits, RhsUnits>>{
+      q.value()};
 }
 
 /// Divides a quantity rvalue by a unit reference, producing a new quantity.
@@ -178,9 +184,9 @@ operator/(const quantity<LhsRep, LhsUnits> &q, RhsUnits &&) {
 /// The input quantity's value is moved into the new quantity.
 ///
 template <rep LhsRep, units LhsUnits, units RhsUnits>
-constexpr quantity<LhsRep, mult<LhsUnits, pow<RhsUnits, -1>>>
+constexpr quantity<LhsRep, detail::quotient_units_t<LhsUnits, RhsUnits>>
 operator/(quantity<LhsRep, LhsUnits> &&q, RhsUnits &&) {
-  return quantity<LhsRep, mult<LhsUnits, pow<RhsUnits, -1>>>{
+  return quantity<LhsRep, detail::quotient_units_t<LhsUnits, RhsUnits>>{
       std::move(q).value()};
 }
 
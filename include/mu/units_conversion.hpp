@@ -1,12 +1,38 @@
 #ifndef INCLUDED_MU_UNITS_CONVERSION_HPP
 #define INCLUDED_MU_UNITS_CONVERSION_HPP
+#include <cstdint>
+#include <limits>
 #include <mu/detail/analysis.hpp>
 #include <mu/units.hpp>
+#include <type_traits>
 
 namespace mu {
 
 namespace detail {
 
+/// The narrowest signed integer type that can hold `Value`.
+///
+/// \tparam Value The integer value.
+///
+template <std::intmax_t Value>
+using narrowest_int_t = std::conditional_t<
+    /* if   */ Value >= std::numeric_limits<std::int8_t>::min() &&
+                   Value <= std::numeric_limits<std::int8_t>::max(),
+    /* then */ std::int8_t,
+    /* elif */ std::conditional_t<
+        Value >= std::numeric_limits<std::int16_t>::min() &&
+            Value <= std::numeric_limits<std::int16_t>::max(),
+        /* then */ std::int16_t,
+        /* elif */ std::conditional_t<
+            Value >= std::numeric_limits<std::int32_t>::min() &&
+                Value <= std::numeric_limits<std::int32_t>::max(),
+            /* then */ std::int32_t,
+            /* elif */ std::conditional_t<
+                Value >= std::numeric_limits<std::int64_t>::min() &&
+                    Value <= std::numeric_limits<std::int64_t>::max(),
+                /* then */ std::int64_t,
+                /* else */ std::intmax_t>>>>;
+
 /// A template struct that defines the multiplier needed to convert `FromUnits`
 /// to `ToUnits`. The value may be an integer, or a floating point value.
 ///
@@ -20,32 +46,27 @@ namespace detail {
 template <units FromUnits, units ToUnits> struct units_conversion {
 private:
   constexpr static auto &ao = analysis_object<FromUnits, ToUnits>;
-  constexpr static bool fits_int8 =
-      ao.int_conversion >= std::numeric_limits<int8_t>::min() &&
-      ao.int_conversion <= std::numeric_limits<int8_t>::max();
-  constexpr static bool fits_int16 =
-      ao.int_conversion >= std::numeric_limits<int16_t>::min() &&
-      ao.int_conversion <= std::numeric_limits<int16_t>::max();
-  constexpr static bool fits_int32 =
-      ao.int_conversion >= std::numeric_limits<int32_t>::min() &&
-      ao.int_conversion <= std::numeric_limits<int32_t>::max();
-  constexpr static bool fits_int64 =
-      ao.int_conversion >= std::numeric_limits<int64_t>::min() &&
-      ao.int_conversion <= std::numeric_limits<int64_t>::max();
 
 public:
-  // clang-format off
-  using type = std::conditional_t<
-      /* if   */ !ao.is_int_convertible,        /* then */ long double,
-      /* elif */ std::conditional_t<fits_int8,  /* then */ std::int8_t,
-      /* elif */ std::conditional_t<fits_int16, /* then */ std::int16_t,
-      /* elif */ std::conditional_t<fits_int32, /* then */ std::int32_t,
-      /* elif */ std::conditional_t<fits_int64, /* then */ std::int64_t,
-      /* else */ std::intmax_t>>>>>;
-  // clang-format on
+  using type = std::conditional_t<ao.is_int_convertible,
+                                  narrowest_int_t<ao.int_conversion>,
+                                  long double>;
 
   constexpr static auto value = static_cast<type>(
       ao.is_int_convertible ? ao.int_conversion : ao.float_conversion);
+
+  /// True if the conversion is not an integer, but is the ratio `ratio_num /
+  /// ratio_den` of two integers whose product does not overflow. Integral
+  /// values can then be converted exactly in integer arithmetic.
+  constexpr static bool is_int_ratio =
+      ao.is_ratio_convertible && !ao.is_int_convertible &&
+      safe_mult(ao.int_conversion, ao.int_divisor).has_value();
+
+  /// Numerator of the conversion ratio.
+  constexpr static std::intmax_t ratio_num = ao.int_conversion;
+
+  /// Positive denominator of the conversion ratio.
+  constexpr static std::intmax_t ratio_den = ao.int_divisor;
 };
 
 } // namespace detail
@@ -160,3 +160,26 @@ TEST(MuAnalysis, FloatMultOverflow) {
   analysis<from, to> a;
   ASSERT_FALSE(a.is_convertible);
 }
+
+CONSTEXPR_TEST(MuAnalysis, LargePrimeScalesCancel) {
+  // Each scale is a product of primes beyond the primes table.
+  using from = mu::mult<std::ratio<999983LL * 1000003LL>, apples>;
+  using to = mu::mult<std::ratio<1000003>, apples>;
+  static_assert(analysis_object<from, to>.is_convertible);
+  static_assert(analysis_object<from, to>.is_int_convertible);
+  static_assert(analysis_object<from, to>.int_conversion == 999983);
+}
+
+CONSTEXPR_TEST(MuAnalysis, RatioConversion) {
+  using from = mu::mult<std::ratio<60>, apples>;
+  using to = mu::mult<std::ratio<3600>, apples>;
+  static_assert(!analysis_object<from, to>.is_int_convertible);
+  static_assert(analysis_object<from, to>.is_ratio_convertible);
+  static_assert(analysis_object<from, to>.int_conversion == 1);
+  static_assert(analysis_object<from, to>.int_divisor == 60);
+  static_assert(is_equal(analysis_object<from, to>.float_conversion,
+                         1.0l / 60.0l));
+
+  using sqrt_2_apples = mu::mult<mu::pow<std::ratio<2>, 1, 2>, apples>;
+  static_assert(!analysis_object<apples, sqrt_2_apples>.is_ratio_convertible);
+}
@@ -0,0 +1,104 @@
+#include "mu_test.hpp"
+#include <mu/units/si_units.hpp>
+#include <type_traits>
+
+using mu::detail::canonical_units_t;
+
+CONSTEXPR_TEST(MuCanonical, SingleUnit) {
+  static_assert(std::is_same_v<canonical_units_t<apples>, apples>);
+  static_assert(std::is_same_v<canonical_units_t<mu::mult<apples>>, apples>);
+}
+
+CONSTEXPR_TEST(MuCanonical, OrderIndependent) {
+  using a = canonical_units_t<mu::mult<apples, oranges>>;
+  using b = canonical_units_t<mu::mult<oranges, apples>>;
+  static_assert(std::is_same_v<a, b>);
+}
+
+CONSTEXPR_TEST(MuCanonical, NestedProductsAreFlat) {
+  using nested = mu::mult<mu::mult<mu::mult<apples, oranges>, mu::meter>,
+                          mu::pow<mu::mult<mu::second, apples>, -1>>;
+  using flat = mu::mult<oranges, mu::meter, mu::per<mu::second>>;
+  static_assert(
+      std::is_same_v<canonical_units_t<nested>, canonical_units_t<flat>>);
+}
+
+CONSTEXPR_TEST(MuCanonical, CombineSameUnits) {
+  using u = canonical_units_t<mu::mult<mu::meter, mu::meter, mu::meter>>;
+  static_assert(std::is_same_v<u, mu::pow<mu::meter, 3>>);
+}
+
+CONSTEXPR_TEST(MuCanonical, DropCancelledUnits) {
+  using u = mu::mult<apples, mu::per<apples>>;
+  static_assert(std::is_same_v<canonical_units_t<u>, mu::mult<>>);
+}
+
+CONSTEXPR_TEST(MuCanonical, NamedUnitsAreKept) {
+  using u = canonical_units_t<mu::mult<mu::newton, mu::meter>>;
+  static_assert(std::is_same_v<u, canonical_units_t<mu::mult<mu::meter,
+                                                             mu::newton>>>);
+  static_assert(std::tuple_size_v<u> == 2);
+}
+
+CONSTEXPR_TEST(MuCanonical, PrefixStaysAttached) {
+  using u = canonical_units_t<mu::mult<mu::second, mu::kilo, mu::meter>>;
+  using v = canonical_units_t<mu::mult<mu::kilo, mu::meter, mu::second>>;
+  static_assert(std::is_same_v<u, v>);
+  static_assert(std::tuple_size_v<u> == 2);
+}
+
+CONSTEXPR_TEST(MuCanonical, Idempotent) {
+  using u = canonical_units_t<
+      mu::mult<mu::per<mu::second>, mu::meter, mu::pow<apples, 1, 2>>>;
+  static_assert(std::is_same_v<canonical_units_t<u>, u>);
+}
+
+#if defined(MU_CANONICAL_ARITHMETIC)
+
+CONSTEXPR_TEST(MuCanonicalArithmetic, ProductIsCommutative) {
+  constexpr mu::quantity<int, apples> a{2};
+  constexpr mu::quantity<int, oranges> b{3};
+  static_assert(std::is_same_v<decltype(a * b), decltype(b * a)>);
+  static_assert((a * b).value() == 6);
+}
+
+CONSTEXPR_TEST(MuCanonicalArithmetic, QuotientCancels) {
+  constexpr mu::quantity<int, mu::mult<apples, oranges>> a{6};
+  constexpr mu::quantity<int, oranges> b{3};
+  static_assert(std::is_same_v<decltype(a / b), mu::quantity<int, apples>>);
+  static_assert((a / b).value() == 2);
+}
+
+CONSTEXPR_TEST(MuCanonicalArithmetic, Reciprocal) {
+  constexpr mu::quantity<int, mu::per<apples>> a{2};
+  static_assert(std::is_same_v<decltype(1 / a), mu::quantity<int, apples>>);
+}
+
+CONSTEXPR_TEST(MuCanonicalArithmetic, UnitReferences) {
+  static_assert(std::is_same_v<decltype(mu::meter{} * mu::second{}),
+                               decltype(mu::second{} * mu::meter{})>);
+  static_assert(
+      std::is_same_v<decltype(mu::meter{} / mu::meter{}), mu::mult<>>);
+}
+
+#else
+
+CONSTEXPR_TEST(MuCanonicalArithmetic, DisabledByDefault) {
+  constexpr mu::quantity<int, apples> a{2};
+  constexpr mu::quantity<int, oranges> b{3};
+  static_assert(std::is_same_v<decltype(a * b),
+                               mu::quantity<int, mu::mult<apples, oranges>>>);
+}
+
+#endif
+
+TEST(MuCanonicalArithmetic, LongFormula) {
+  mu::quantity<double, mu::meter> x{2.0};
+  mu::quantity<double, mu::second> t{4.0};
+  auto v = x / t;
+  auto a = v / t;
+  auto e = a * x * x / (t * t) * t * t / x;
+  mu::quantity<double, mu::mult<mu::pow<mu::meter, 2>, mu::per<mu::second, 2>>>
+      expected{e};
+  ASSERT_DOUBLE_EQ(expected.value(), 0.25);
+}
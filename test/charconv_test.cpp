@@ -0,0 +1,133 @@
+#include "mu_test.hpp"
+#include <array>
+#include <mu/units/si_units.hpp>
+#include <string_view>
+
+struct MuCharconvTest : public testing::Test {
+  mu::format_options opts;
+  std::array<char, 64> buf{};
+
+  template <mu::rep Rep, mu::units Units>
+  std::string_view write(const mu::quantity<Rep, Units> &q) {
+    auto [ptr, ec] =
+        mu::to_chars(buf.data(), buf.data() + buf.size(), q, opts);
+    EXPECT_EQ(ec, std::errc{});
+    return {buf.data(), static_cast<std::size_t>(ptr - buf.data())};
+  }
+};
+
+TEST_F(MuCharconvTest, ToChars) {
+  auto q = 3 * apples{} * mu::pow<oranges, -2>{};
+  ASSERT_EQ(write(q), "3 apples * oranges^-2");
+}
+
+TEST_F(MuCharconvTest, ToCharsOptions) {
+  auto q = 2.5 * apples{} * mu::pow<oranges, 2>{};
+  opts.labels = mu::format_options::label_type::symbols;
+  opts.superscript_exponents = true;
+  opts.mult_sep = " • ";
+  ASSERT_EQ(write(q), "2.5 🍎 • 🍊²");
+}
+
+TEST_F(MuCharconvTest, ToCharsTooSmallForValue) {
+  auto q = 12345 * apples{};
+  auto [ptr, ec] = mu::to_chars(buf.data(), buf.data() + 3, q);
+  ASSERT_EQ(ec, std::errc::value_too_large);
+  ASSERT_EQ(ptr, buf.data() + 3);
+}
+
+TEST_F(MuCharconvTest, ToCharsTooSmallForUnits) {
+  auto q = 12 * apples{};
+  // "12 apples" is 9 characters.
+  auto [ptr, ec] = mu::to_chars(buf.data(), buf.data() + 8, q);
+  ASSERT_EQ(ec, std::errc::value_too_large);
+  ASSERT_EQ(ptr, buf.data() + 8);
+  auto result = mu::to_chars(buf.data(), buf.data() + 9, q);
+  ASSERT_EQ(result.ec, std::errc{});
+  ASSERT_EQ(result.ptr, buf.data() + 9);
+}
+
+TEST_F(MuCharconvTest, FromChars) {
+  std::string_view text = "12.5 apples * oranges";
+  mu::quantity<double, mu::mult<apples, oranges>> q;
+  auto [ptr, ec] = mu::from_chars(text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(ptr, text.data() + text.size());
+  ASSERT_EQ(q.value(), 12.5);
+}
+
+TEST_F(MuCharconvTest, FromCharsSymbolsAndCustomSep) {
+  std::string_view text = "7 🍎 • 🍊² rest";
+  opts.mult_sep = " • ";
+  mu::quantity<int, mu::mult<apples, mu::pow<oranges, 2>>> q;
+  auto [ptr, ec] =
+      mu::from_chars(text.data(), text.data() + text.size(), q, opts);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(std::string_view(ptr), " rest");
+  ASSERT_EQ(q.value(), 7);
+}
+
+TEST_F(MuCharconvTest, FromCharsAlternativeUnits) {
+  std::string_view text = "1.5 km";
+  mu::quantity<double, mu::meter> q;
+  auto [ptr, ec] = mu::from_chars<double, mu::meter, mu::kilometer>(
+      text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(ptr, text.data() + text.size());
+  ASSERT_DOUBLE_EQ(q.value(), 1500.0);
+}
+
+TEST_F(MuCharconvTest, FromCharsLongestMatch) {
+  std::string_view text = "4 apples * oranges";
+  mu::quantity<int, apples> q{0};
+  auto [ptr, ec] = mu::from_chars(text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(std::string_view(ptr), " * oranges");
+}
+
+TEST_F(MuCharconvTest, FromCharsLongestMatchAcrossUnits) {
+  // "m" is a prefix of "mm", but the longer label wins.
+  std::string_view text = "3 mm";
+  mu::quantity<double, mu::meter> q;
+  auto [ptr, ec] = mu::from_chars<double, mu::meter, mu::millimeter>(
+      text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(ptr, text.data() + text.size());
+  ASSERT_DOUBLE_EQ(q.value(), 0.003);
+}
+
+TEST_F(MuCharconvTest, FromCharsUnknownUnits) {
+  std::string_view text = "4 oranges";
+  mu::quantity<int, apples> q{1};
+  auto [ptr, ec] = mu::from_chars(text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc::invalid_argument);
+  ASSERT_EQ(ptr, text.data());
+  ASSERT_EQ(q.value(), 1);
+}
+
+TEST_F(MuCharconvTest, FromCharsMissingUnits) {
+  std::string_view text = "4";
+  mu::quantity<int, apples> q{1};
+  auto [ptr, ec] = mu::from_chars(text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc::invalid_argument);
+  ASSERT_EQ(ptr, text.data());
+}
+
+TEST_F(MuCharconvTest, FromCharsInvalidValue) {
+  std::string_view text = "x apples";
+  mu::quantity<int, apples> q{1};
+  auto [ptr, ec] = mu::from_chars(text.data(), text.data() + text.size(), q);
+  ASSERT_EQ(ec, std::errc::invalid_argument);
+  ASSERT_EQ(ptr, text.data());
+}
+
+TEST_F(MuCharconvTest, RoundTrip) {
+  auto q = 0.1 * mu::kilometer{} * mu::per<mu::hour>{};
+  opts.labels = mu::format_options::label_type::symbols;
+  auto text = write(q);
+  decltype(q) r;
+  auto [ptr, ec] =
+      mu::from_chars(text.data(), text.data() + text.size(), r, opts);
+  ASSERT_EQ(ec, std::errc{});
+  ASSERT_EQ(r.value(), q.value());
+}
@@ -0,0 +1,166 @@
+#include "mu_test.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mu/units/si_units.hpp>
+
+using mu::checked_quantity_cast;
+using mu::rounding;
+using mu::saturating_quantity_cast;
+using mu::detail::checked_conversion;
+
+CONSTEXPR_TEST(MuCheckedCast, IntegerScaleBounds) {
+  using conversion = checked_conversion<std::int32_t, mu::kilometer,
+                                        std::int32_t, mu::millimeter,
+                                        rounding::truncate>;
+  static_assert(conversion::is_exact);
+  static_assert(!conversion::always_fits);
+  static_assert(conversion::min_value == -2147);
+  static_assert(conversion::max_value == 2147);
+
+  constexpr mu::quantity<std::int32_t, mu::kilometer> fits{2147};
+  constexpr mu::quantity<std::int32_t, mu::kilometer> wraps{2148};
+  static_assert(checked_quantity_cast<std::int32_t, mu::millimeter>(fits)
+                    ->value() == 2'147'000'000);
+  static_assert(!checked_quantity_cast<std::int32_t, mu::millimeter>(wraps));
+  static_assert(
+      saturating_quantity_cast<std::int32_t, mu::millimeter>(wraps).value() ==
+      std::numeric_limits<std::int32_t>::max());
+  static_assert(saturating_quantity_cast<std::int32_t, mu::millimeter>(-wraps)
+                    .value() == std::numeric_limits<std::int32_t>::min());
+}
+
+CONSTEXPR_TEST(MuCheckedCast, ChecksSkippedWhenEveryValueFits) {
+  static_assert(checked_conversion<std::int16_t, mu::meter, std::int64_t,
+                                   mu::millimeter,
+                                   rounding::truncate>::always_fits);
+  static_assert(checked_conversion<std::int32_t, mu::millisecond,
+                                   std::int32_t, mu::second,
+                                   rounding::nearest>::always_fits);
+  static_assert(checked_conversion<std::uint8_t, apples, std::int16_t, apples,
+                                   rounding::truncate>::always_fits);
+  static_assert(checked_conversion<std::int32_t, golden_apples, std::int64_t,
+                                   apples, rounding::truncate>::always_fits);
+  static_assert(!checked_conversion<std::int64_t, golden_apples, std::int64_t,
+                                    apples, rounding::truncate>::always_fits);
+}
+
+CONSTEXPR_TEST(MuCheckedCast, LimitsOfInt64) {
+  using conversion = checked_conversion<std::int64_t, mu::millisecond,
+                                        std::int64_t, mu::nanosecond,
+                                        rounding::truncate>;
+  static_assert(conversion::max_value ==
+                std::numeric_limits<std::int64_t>::max() / 1'000'000);
+  static_assert(conversion::min_value ==
+                std::numeric_limits<std::int64_t>::min() / 1'000'000);
+
+  constexpr mu::quantity<std::uint64_t, apples> big{
+      std::numeric_limits<std::uint64_t>::max()};
+  static_assert(!checked_quantity_cast<std::int64_t, apples>(big));
+  static_assert(saturating_quantity_cast<std::int64_t, apples>(big).value() ==
+                std::numeric_limits<std::int64_t>::max());
+}
+
+CONSTEXPR_TEST(MuCheckedCast, RatioScale) {
+  // Converting apples to two-thirds of an apple multiplies by 3/2.
+  using two_thirds_apples = mu::mult<std::ratio<2, 3>, apples>;
+  using conversion =
+      checked_conversion<std::int32_t, apples, std::int32_t, two_thirds_apples,
+                         rounding::ceil>;
+  static_assert(conversion::is_exact);
+
+  // 1431655765 * 3 / 2 = 2147483647.5, which rounds up past the maximum.
+  static_assert(conversion::max_value == 1'431'655'764);
+  static_assert(conversion::min_value == -1'431'655'765);
+
+  constexpr mu::quantity<std::int32_t, apples> a{1'431'655'764};
+  constexpr mu::quantity<std::int32_t, apples> b{1'431'655'765};
+  static_assert(
+      checked_quantity_cast<std::int32_t, two_thirds_apples, rounding::ceil>(a)
+          ->value() == 2'147'483'646);
+  static_assert(!checked_quantity_cast<std::int32_t, two_thirds_apples,
+                                       rounding::ceil>(b));
+  static_assert(checked_quantity_cast<std::int32_t, two_thirds_apples,
+                                      rounding::floor>(b)
+                    ->value() == 2'147'483'647);
+}
+
+CONSTEXPR_TEST(MuCheckedCast, NegativeScale) {
+  using n8_oranges = mu::mult<std::ratio<-8>, oranges>;
+  constexpr mu::quantity<std::int32_t, n8_oranges> fits{268'435'456};
+  constexpr mu::quantity<std::int32_t, n8_oranges> wraps{268'435'457};
+  static_assert(checked_quantity_cast<std::int32_t, oranges>(fits)->value() ==
+                std::numeric_limits<std::int32_t>::min());
+  static_assert(!checked_quantity_cast<std::int32_t, oranges>(wraps));
+  static_assert(
+      saturating_quantity_cast<std::int32_t, oranges>(wraps).value() ==
+      std::numeric_limits<std::int32_t>::min());
+  static_assert(
+      saturating_quantity_cast<std::int32_t, oranges>(-wraps).value() ==
+      std::numeric_limits<std::int32_t>::max());
+}
+
+CONSTEXPR_TEST(MuCheckedCast, UnsignedDestination) {
+  constexpr mu::quantity<int, apples> a{-1};
+  static_assert(!checked_quantity_cast<unsigned, apples>(a));
+  static_assert(saturating_quantity_cast<unsigned, apples>(a).value() == 0);
+  static_assert(checked_quantity_cast<unsigned, apples>(-a)->value() == 1);
+}
+
+CONSTEXPR_TEST(MuCheckedCast, FloatRounding) {
+  using q = mu::quantity<double, apples>;
+  static_assert(checked_quantity_cast<std::int8_t, apples, rounding::nearest>(
+                    q{127.4})
+                    ->value() == 127);
+  static_assert(
+      !checked_quantity_cast<std::int8_t, apples, rounding::nearest>(q{127.5}));
+  static_assert(
+      checked_quantity_cast<std::int8_t, apples, rounding::ceil>(q{126.5})
+          ->value() == 127);
+  static_assert(
+      !checked_quantity_cast<std::int8_t, apples, rounding::ceil>(q{127.01}));
+  static_assert(
+      checked_quantity_cast<std::int8_t, apples, rounding::floor>(q{-127.5})
+          ->value() == -128);
+  static_assert(
+      !checked_quantity_cast<std::int8_t, apples, rounding::floor>(q{-128.5}));
+  static_assert(checked_quantity_cast<std::int8_t, apples>(q{-128.9})
+                    ->value() == -128);
+  static_assert(!checked_quantity_cast<std::int8_t, apples>(q{-129.0}));
+  static_assert(checked_quantity_cast<std::int8_t, apples>(q{127.9})
+                    ->value() == 127);
+  static_assert(!checked_quantity_cast<std::int8_t, apples>(q{128.0}));
+}
+
+TEST(MuCheckedCast, FloatOutOfRange) {
+  const mu::quantity<double, mu::second> huge{1e300};
+  const mu::quantity<double, mu::second> nan{std::nan("")};
+  ASSERT_FALSE((checked_quantity_cast<std::int32_t, mu::minute>(huge)));
+  ASSERT_FALSE((checked_quantity_cast<std::int32_t, mu::minute>(nan)));
+  ASSERT_EQ((saturating_quantity_cast<std::int32_t, mu::minute>(huge).value()),
+            std::numeric_limits<std::int32_t>::max());
+  ASSERT_EQ((saturating_quantity_cast<std::int32_t, mu::minute>(-huge).value()),
+            std::numeric_limits<std::int32_t>::min());
+  ASSERT_EQ((saturating_quantity_cast<std::int32_t, mu::minute>(nan).value()),
+            0);
+}
+
+TEST(MuCheckedCast, MatchesQuantityCast) {
+  using two_thirds_apples = mu::mult<std::ratio<2, 3>, apples>;
+  for (std::int32_t value : {-1000, -7, -1, 0, 1, 5, 999, 123'456}) {
+    const mu::quantity<std::int32_t, apples> a{value};
+    ASSERT_EQ(
+        (checked_quantity_cast<std::int32_t, two_thirds_apples,
+                               rounding::nearest>(a)
+             ->value()),
+        (mu::quantity_cast<std::int32_t, two_thirds_apples, rounding::nearest>(
+             a)
+             .value()));
+    ASSERT_EQ((saturating_quantity_cast<std::int32_t, golden_apples,
+                                        rounding::floor>(a)
+                   .value()),
+              (mu::quantity_cast<std::int32_t, golden_apples, rounding::floor>(
+                   a)
+                   .value()));
+  }
+}
@@ -70,6 +70,7 @@ CONSTEXPR_TEST(MuConcreteFactor, CompositeConstant) {
   static_assert(!f0.is_dimensional);
   static_assert(!f0.is_rational_value);
   static_assert(f0.irrational_value == universal_fruit_constant::value);
+  static_assert(f0.rational_primes == nullptr);
 
   // check f1
   constexpr concrete_factor f1 = fs[1];
@@ -82,4 +83,32 @@ CONSTEXPR_TEST(MuConcreteFactor, CompositeConstant) {
   static_assert(f2.base_id == i2);
   static_assert(f2.exponent == ratio{1});
   static_assert(f2.is_dimensional);
-}
\ No newline at end of file
+}
+
+CONSTEXPR_TEST(MuConcreteFactor, RepeatedBases) {
+  using t = mult<oranges, apples, mu::pow<oranges, -1>, apples, golden>;
+  using g = concrete_factor_generator<typename unit_traits<t>::factors>;
+  constexpr auto fs = g::make_concrete_factors();
+  static_assert(fs.size() == 5);
+
+  // Each base id is the index of the first factor with that base.
+  static_assert(g::base_id<oranges> == 0);
+  static_assert(g::base_id<apples> == 1);
+  static_assert(fs[0].base_id == fs[2].base_id);
+  static_assert(fs[1].base_id == fs[3].base_id);
+  static_assert(fs[4].base_id == 4);
+  static_assert(g::base_id<funky> == UNKNOWN_BASE_ID);
+}
+
+CONSTEXPR_TEST(MuConcreteFactor, SharedRationalPrimes) {
+  using t = mult<std::ratio<60>, apples, mu::pow<std::ratio<60>, 2>>;
+  using g = concrete_factor_generator<typename unit_traits<t>::factors>;
+  constexpr auto fs = g::make_concrete_factors();
+  static_assert(fs.size() == 3);
+
+  // Both rational factors point to the same factorization of their value.
+  static_assert(fs[0].rational_primes ==
+                &mu::detail::ratio_prime_factors<60, 1>);
+  static_assert(fs[2].rational_primes == fs[0].rational_primes);
+  static_assert(fs[1].rational_primes == nullptr);
+}
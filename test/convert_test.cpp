@@ -0,0 +1,70 @@
+#include "mu_test.hpp"
+#include <array>
+#include <cstdint>
+#include <mu/units/si_units.hpp>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+CONSTEXPR_TEST(MuConvert, ConstantEvaluated) {
+  constexpr auto converted = [] {
+    const std::array<mu::quantity<int, mu::kilometer>, 3> km{
+        mu::quantity<int, mu::kilometer>{1},
+        mu::quantity<int, mu::kilometer>{2},
+        mu::quantity<int, mu::kilometer>{-3}};
+    std::array<mu::quantity<long, mu::meter>, 3> m{};
+    mu::convert(km, m);
+    return m;
+  }();
+  static_assert(converted[0].value() == 1000);
+  static_assert(converted[1].value() == 2000);
+  static_assert(converted[2].value() == -3000);
+}
+
+TEST(MuConvert, VectorToVector) {
+  const std::vector<mu::quantity<std::int32_t, mu::millisecond>> ms{
+      mu::quantity<std::int32_t, mu::millisecond>{1500},
+      mu::quantity<std::int32_t, mu::millisecond>{-250}};
+  std::vector<mu::quantity<double, mu::second>> s(ms.size());
+  const auto written = mu::convert(ms, s);
+  ASSERT_EQ(written.data(), s.data());
+  ASSERT_EQ(written.size(), 2);
+  ASSERT_DOUBLE_EQ(s[0].value(), 1.5);
+  ASSERT_DOUBLE_EQ(s[1].value(), -0.25);
+}
+
+TEST(MuConvert, SpansOfDifferentSizes) {
+  std::array<mu::quantity<float, mu::millimeter>, 4> mm{};
+  mm[0] = mu::quantity<float, mu::millimeter>{250.0f};
+  mm[1] = mu::quantity<float, mu::millimeter>{500.0f};
+  std::array<mu::quantity<float, mu::meter>, 4> m{};
+  m[2] = mu::quantity<float, mu::meter>{7.0f};
+
+  // Converts the first two elements only, and leaves the rest untouched.
+  const auto written = mu::convert(
+      std::span<const mu::quantity<float, mu::millimeter>>{mm}.first(2),
+      std::span<mu::quantity<float, mu::meter>>{m});
+  ASSERT_EQ(written.size(), 2);
+  ASSERT_FLOAT_EQ(m[0].value(), 0.25f);
+  ASSERT_FLOAT_EQ(m[1].value(), 0.5f);
+  ASSERT_FLOAT_EQ(m[2].value(), 7.0f);
+}
+
+TEST(MuConvert, OutputTooSmall) {
+  const std::vector<mu::quantity<int, apples>> in(3);
+  std::vector<mu::quantity<int, apples>> out(2);
+  ASSERT_THROW(mu::convert(in, out), std::length_error);
+}
+
+CONSTEXPR_TEST(MuConvert, OnlyLosslessConversions) {
+  using meters = std::vector<mu::quantity<double, mu::meter>>;
+  using int_kilometers = std::vector<mu::quantity<int, mu::kilometer>>;
+  using seconds = std::vector<mu::quantity<double, mu::second>>;
+  static_assert(
+      mu::detail::quantity_range_convertible_to<int_kilometers, meters &>);
+  static_assert(
+      !mu::detail::quantity_range_convertible_to<meters, int_kilometers &>);
+  static_assert(!mu::detail::quantity_range_convertible_to<meters, seconds &>);
+  static_assert(!mu::detail::quantity_range_convertible_to<int_kilometers,
+                                                           const meters &>);
+}
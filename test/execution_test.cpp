@@ -0,0 +1,60 @@
+#include "mu_test.hpp"
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <mu/execution.hpp>
+#include <mu/units/si_units.hpp>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+TEST(MuExecution, ConvertInParallel) {
+  std::vector<mu::quantity<std::int32_t, mu::kilometer>> km(100'000);
+  for (std::size_t i = 0; i < km.size(); ++i) {
+    km[i] = mu::quantity<std::int32_t, mu::kilometer>{static_cast<int>(i)};
+  }
+  std::vector<mu::quantity<std::int64_t, mu::millimeter>> mm(km.size());
+  const auto written = mu::convert(std::execution::par_unseq, km, mm);
+  ASSERT_EQ(written.size(), km.size());
+  for (std::size_t i = 0; i < km.size(); ++i) {
+    ASSERT_EQ(mm[i].value(), static_cast<std::int64_t>(i) * 1'000'000);
+  }
+}
+
+TEST(MuExecution, ConvertOutputTooSmall) {
+  const std::vector<mu::quantity<int, apples>> in(3);
+  std::vector<mu::quantity<int, apples>> out(2);
+  ASSERT_THROW(mu::convert(std::execution::seq, in, out), std::length_error);
+}
+
+TEST(MuExecution, ReduceInParallel) {
+  std::vector<mu::quantity<double, mu::meter>> m(200'001);
+  for (std::size_t i = 0; i < m.size(); ++i) {
+    m[i] = mu::quantity<double, mu::meter>{static_cast<double>(i % 1000)};
+  }
+  ASSERT_EQ(mu::reduce::sum(std::execution::par, m).value(),
+            mu::reduce::sum(std::execution::seq, m).value());
+  ASSERT_EQ(mu::reduce::sum<mu::summation::compensated>(std::execution::par, m)
+                .value(),
+            99'900'000.0);
+  ASSERT_EQ(mu::reduce::mean(std::execution::par_unseq, m).value(),
+            99'900'000.0 / m.size());
+  ASSERT_EQ(mu::reduce::min(std::execution::par, m).value(), 0.0);
+  ASSERT_EQ(mu::reduce::max(std::execution::par, m).value(), 999.0);
+  ASSERT_EQ(mu::reduce::sum_of_squares(std::execution::par, m).value(),
+            mu::reduce::dot(std::execution::par, m, m).value());
+  ASSERT_EQ(mu::reduce::norm(std::execution::par, m).value(),
+            std::sqrt(mu::reduce::sum_of_squares(m).value()));
+}
+
+TEST(MuExecution, ReduceIntegers) {
+  std::vector<mu::quantity<std::int64_t, apples>> a(100'000);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = mu::quantity<std::int64_t, apples>{static_cast<std::int64_t>(i)};
+  }
+  ASSERT_EQ(mu::reduce::sum(std::execution::par, a).value(),
+            4'999'950'000);
+  ASSERT_THROW(mu::reduce::dot(std::execution::par, a,
+                               std::span{a}.first(10)),
+               std::length_error);
+}
@@ -0,0 +1,229 @@
+#include "mu_test.hpp"
+#include <cstdint>
+#include <mu/fixed.hpp>
+#include <mu/units/si_units.hpp>
+#include <type_traits>
+
+using mu::quantity;
+using mu::quantity_cast;
+using mu::rounding;
+using q16 = mu::fixed<std::int32_t, 16>;
+using wide_q16 = mu::fixed<std::int64_t, 16>;
+using q32 = mu::fixed<std::int64_t, 32>;
+using two_meters = mu::mult<std::ratio<2>, mu::meter>;
+
+CONSTEXPR_TEST(MuFixed, Arithmetic) {
+  static_assert(q16{3}.raw() == 3 << 16);
+  static_assert(static_cast<double>(q16::from_raw(3 << 15)) == 1.5);
+  static_assert(-q16{2} == q16{-2});
+  static_assert(q16{1} < q16{2});
+
+  // Sums of one type have that type. Other sums have the integer bits of the
+  // wider operand and the fractional bits of the finer operand.
+  static_assert(std::is_same_v<decltype(q16{} + q16{}), q16>);
+  static_assert(q16{1} + q16{2} == q16{3});
+  static_assert(std::is_same_v<decltype(mu::fixed<std::int8_t, 2>{} +
+                                        mu::fixed<std::int8_t, 2>{}),
+                               mu::fixed<std::int8_t, 2>>);
+  constexpr auto sum = q16{1} + mu::fixed<std::int32_t, 8>{2};
+  static_assert(std::is_same_v<decltype(sum), const wide_q16>);
+  static_assert(sum == wide_q16{3});
+  static_assert(q16{1} - mu::fixed<std::int32_t, 8>{3} == wide_q16{-2});
+
+  // Products have the fractional bits of both operands, in a wider integer.
+  constexpr auto product = q16::from_raw(3 << 15) * q16{3};
+  static_assert(
+      std::is_same_v<decltype(product), const mu::fixed<std::int64_t, 32>>);
+  static_assert(product.raw() == std::int64_t{9} << 31);
+
+  // Quotients have the fractional bits of the dividend, and are truncated.
+  static_assert(q16{3} / q16{2} == q16::from_raw(3 << 15));
+  static_assert(q16{1} / q16{3} == q16::from_raw(21845));
+  static_assert(q16{-1} / q16{3} == q16::from_raw(-21845));
+
+  static_assert(q16{3} * 2 == q16{6});
+  static_assert(2 * q16{3} == q16{6});
+  static_assert(q16{3} / 2 == q16::from_raw(3 << 15));
+}
+
+CONSTEXPR_TEST(MuFixed, SumsKeepIntegerBits) {
+  // The coarser operand needs its high integer bits, and the finer operand its
+  // low fractional bits.
+  using coarse = mu::fixed<std::int16_t, 2>;
+  using fine = mu::fixed<std::int16_t, 14>;
+  constexpr auto sum = coarse{100} + fine{1};
+  static_assert(std::is_same_v<decltype(sum), const mu::fixed<int, 14>>);
+  static_assert(sum == mu::fixed<int, 14>{101});
+  static_assert(coarse{-100} - fine::from_raw(1 << 13) ==
+                mu::fixed<int, 14>::from_raw(-(201 << 13)));
+
+  // Operands that cannot be aligned in 64 bits are not added.
+  using whole64 = mu::fixed<std::int64_t, 0>;
+  static_assert(!mu::rep_addable<whole64, q32>);
+  static_assert(!mu::rep_subtractable<q32, whole64>);
+}
+
+CONSTEXPR_TEST(MuFixed, SumsOfOneType) {
+  // Sums of one type chain, as integer sums do.
+  constexpr q16 a{1};
+  constexpr q16 b = q16::from_raw(1 << 15);
+  constexpr auto sum = a + b + a - b;
+  static_assert(std::is_same_v<decltype(sum), const q16>);
+  static_assert(sum == q16{2});
+
+  // 64-bit values are added without widening.
+  static_assert(std::is_same_v<decltype(q32{} + q32{}), q32>);
+  static_assert(q32{1} + q32{2} - q32{4} == q32{-1});
+  static_assert(wide_q16{1 << 30} + wide_q16{1 << 30} ==
+                wide_q16{std::int64_t{1} << 31});
+  static_assert(std::is_same_v<decltype(q32{} + q16{}), q32>);
+  static_assert(q32{3} + q16::from_raw(1) ==
+                q32::from_raw((std::int64_t{3} << 32) + (1 << 16)));
+}
+
+CONSTEXPR_TEST(MuFixed, WideProductsAndQuotients) {
+  // Dividends of 64 bits are only shifted by divisors without fractional
+  // bits.
+  static_assert(q32{100000} / mu::fixed<std::int64_t, 0>{2} == q32{50000});
+  static_assert(q32{-7} / mu::fixed<std::int32_t, 0>{2} ==
+                q32::from_raw(-(std::int64_t{7} << 31)));
+  static_assert(q32{100000} / 2 == q32{50000});
+  static_assert(!mu::rep_dividable<q32, q32>);
+  static_assert(!mu::rep_dividable<q32, q16>);
+
+  // Products of 64-bit values would need 128 bits.
+  static_assert(!mu::rep_multiplicable<q32, q16>);
+  static_assert(mu::rep_multiplicable<q16, q16>);
+}
+
+CONSTEXPR_TEST(MuFixed, CastsRespectFractionalBits) {
+  using mu::rep_losslessly_castable_to;
+  using mu::rep_lossily_castable_to;
+  static_assert(rep_losslessly_castable_to<mu::fixed<std::int16_t, 8>, q16>);
+  static_assert(rep_losslessly_castable_to<std::int16_t, q16>);
+  static_assert(rep_losslessly_castable_to<std::uint8_t, q16>);
+  static_assert(!rep_losslessly_castable_to<std::int32_t, q16>);
+  static_assert(!rep_losslessly_castable_to<mu::fixed<std::int32_t, 8>, q16>);
+  static_assert(!rep_losslessly_castable_to<q16, mu::fixed<std::int32_t, 8>>);
+  static_assert(
+      !rep_losslessly_castable_to<mu::fixed<std::int16_t, 8>,
+                                  mu::fixed<std::uint32_t, 16>>);
+  static_assert(rep_lossily_castable_to<q16, mu::fixed<std::int32_t, 8>>);
+  static_assert(!rep_lossily_castable_to<double, q16>);
+
+  static_assert(mu::rep_traits<mu::fixed<std::int32_t, 8>>::lossy_cast(
+                    q16::from_raw(0x1ff)) ==
+                mu::fixed<std::int32_t, 8>::from_raw(1));
+  static_assert(mu::rep_traits<q16>::lossless_cast(std::int16_t{-5}) ==
+                q16{-5});
+}
+
+CONSTEXPR_TEST(MuFixed, LosslessConversions) {
+  using mu::quantity_losslessly_convertible_to;
+  static_assert(
+      quantity_losslessly_convertible_to<q16, mu::meter, q16, mu::millimeter>);
+  static_assert(
+      !quantity_losslessly_convertible_to<q16, mu::meter, q16, mu::kilometer>);
+  static_assert(
+      mu::quantity_lossily_convertible_to<q16, mu::meter, q16, mu::kilometer>);
+
+  constexpr quantity<q16, mu::meter> m{q16::from_raw(3 << 15)};
+  constexpr quantity<q16, mu::millimeter> mm = m;
+  static_assert(mm.value() == q16{1500});
+
+  // Meters are twos of meters only with another fractional bit.
+  using whole = mu::fixed<std::int16_t, 0>;
+  using halves = mu::fixed<std::int32_t, 1>;
+  static_assert(
+      quantity_losslessly_convertible_to<whole, mu::meter, halves, two_meters>);
+  static_assert(
+      !quantity_losslessly_convertible_to<whole, mu::meter, whole, two_meters>);
+  constexpr quantity<halves, two_meters> pairs =
+      quantity<whole, mu::meter>{whole{3}};
+  static_assert(pairs.value() == halves::from_raw(3));
+
+  // Integers are fixed-point values without fractional bits.
+  constexpr quantity<q16, mu::millimeter> from_int =
+      quantity<std::int16_t, mu::meter>{-2};
+  static_assert(from_int.value() == q16{-2000});
+}
+
+CONSTEXPR_TEST(MuFixed, LossyConversionsRound) {
+  constexpr quantity<q16, mu::meter> m{q16{3}};
+  // 0.003 km is 196.608 units of 2^-16 km.
+  static_assert(quantity_cast<q16, mu::kilometer>(m).value().raw() == 196);
+  static_assert(quantity_cast<q16, mu::kilometer, rounding::nearest>(m)
+                    .value()
+                    .raw() == 197);
+  static_assert(
+      quantity_cast<q16, mu::kilometer, rounding::floor>(-m).value().raw() ==
+      -197);
+  static_assert(
+      quantity_cast<q16, mu::kilometer, rounding::ceil>(-m).value().raw() ==
+      -196);
+  static_assert(quantity_cast<q16, mu::kilometer, rounding::truncate>(-m)
+                    .value()
+                    .raw() == -196);
+
+  // Ratios of integers are exact before rounding.
+  constexpr quantity<q16, mu::second> s{q16{90}};
+  static_assert(quantity_cast<q16, mu::minute>(s).value() ==
+                q16::from_raw(3 << 15));
+
+  // Casts that drop fractional bits round too.
+  using coarse = mu::fixed<std::int32_t, 1>;
+  constexpr quantity<q16, mu::meter> odd{q16::from_raw(0x1c000)};
+  static_assert(quantity_cast<coarse, mu::meter>(odd).value().raw() == 3);
+  static_assert(quantity_cast<coarse, mu::meter, rounding::ceil>(odd)
+                    .value()
+                    .raw() == 4);
+}
+
+CONSTEXPR_TEST(MuFixed, IrrationalConversions) {
+  constexpr quantity<q16, golden_apples> golden_fruit{q16{2}};
+  constexpr auto plain = quantity_cast<q16, apples>(golden_fruit);
+  constexpr long double expected = 2 * golden::value * 65536;
+  static_assert(plain.value().raw() == static_cast<std::int32_t>(expected));
+  static_assert(quantity_cast<q16, apples, rounding::nearest>(golden_fruit)
+                    .value()
+                    .raw() == static_cast<std::int32_t>(expected + 0.5L));
+  static_assert(quantity_cast<q16, apples, rounding::nearest>(-golden_fruit)
+                    .value()
+                    .raw() == -static_cast<std::int32_t>(expected + 0.5L));
+}
+
+CONSTEXPR_TEST(MuFixed, QuantityArithmetic) {
+  constexpr quantity<q16, mu::meter> a{q16{3}};
+  constexpr quantity<q16, mu::meter> b{q16::from_raw(1 << 15)};
+  static_assert((a + b).value() == q16::from_raw(7 << 15));
+  static_assert((a - b).value() == q16::from_raw(5 << 15));
+  constexpr auto chained = a + b + a;
+  static_assert(
+      std::is_same_v<decltype(chained), const quantity<q16, mu::meter>>);
+  static_assert(chained.value() == q16::from_raw(13 << 15));
+
+  constexpr auto area = a * b;
+  static_assert(std::is_same_v<decltype(area)::rep_type,
+                               mu::fixed<std::int64_t, 32>>);
+  static_assert(area.value().raw() == std::int64_t{3} << 31);
+
+  constexpr quantity<q16, mu::millimeter> mm = a;
+  static_assert((mm + a).value() == q16{6000});
+  static_assert((mm + a + mm).value() == q16{9000});
+}
+
+TEST(MuFixed, Runtime) {
+  volatile std::int32_t raw = 3 << 16;
+  const quantity<q16, mu::meter> m{q16::from_raw(raw)};
+  const quantity<q16, mu::millimeter> mm = m;
+  ASSERT_EQ(mm.value(), q16{3000});
+
+  const auto km = quantity_cast<q16, mu::kilometer>(m);
+  ASSERT_EQ(km.value().raw(), 196);
+
+  const quantity<q16, golden_apples> golden_fruit{q16::from_raw(raw)};
+  const auto plain = quantity_cast<q16, apples>(golden_fruit);
+  ASSERT_EQ(plain.value().raw(),
+            static_cast<std::int32_t>(3 * golden::value * 65536));
+  ASSERT_DOUBLE_EQ(static_cast<double>(mm.value()), 3000.0);
+}
@@ -0,0 +1,135 @@
+#include "mu_test.hpp"
+#include <array>
+#include <iterator>
+#include <mu/format.hpp>
+#include <string>
+#include <string_view>
+
+using mu::detail::parse_quantity_format_spec;
+
+CONSTEXPR_TEST(MuFormat, ParseEmptySpec) {
+  constexpr auto spec = parse_quantity_format_spec("");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.value_spec.empty());
+  static_assert(spec.opts.labels == mu::format_options::label_type::names);
+  static_assert(!spec.opts.superscript_exponents);
+  static_assert(spec.mult_sep == " * ");
+}
+
+CONSTEXPR_TEST(MuFormat, ParseValueSpecOnly) {
+  constexpr auto spec = parse_quantity_format_spec(">10.3f");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.value_spec == ">10.3f");
+  static_assert(spec.mult_sep == " * ");
+}
+
+CONSTEXPR_TEST(MuFormat, ParseAllOptions) {
+  constexpr auto spec = parse_quantity_format_spec(".3f;sym;sup; • ");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.value_spec == ".3f");
+  static_assert(spec.opts.labels == mu::format_options::label_type::symbols);
+  static_assert(spec.opts.superscript_exponents);
+  static_assert(spec.mult_sep == " • ");
+}
+
+CONSTEXPR_TEST(MuFormat, ParseSimplified) {
+  constexpr auto spec = parse_quantity_format_spec(";simp");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.opts.simplified);
+  static_assert(spec.mult_sep == " * ");
+}
+
+CONSTEXPR_TEST(MuFormat, ParseLastKeywordIsNotSeparator) {
+  constexpr auto spec = parse_quantity_format_spec(";ascii;name");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.opts.labels == mu::format_options::label_type::names);
+  static_assert(!spec.opts.superscript_exponents);
+  static_assert(spec.mult_sep == " * ");
+}
+
+CONSTEXPR_TEST(MuFormat, ParseSkipsEmptyFields) {
+  constexpr auto spec = parse_quantity_format_spec(";;sup");
+  static_assert(spec.error == nullptr);
+  static_assert(spec.opts.superscript_exponents);
+}
+
+CONSTEXPR_TEST(MuFormat, ParseInvalidOption) {
+  constexpr auto spec = parse_quantity_format_spec(";symbol;x");
+  static_assert(spec.error != nullptr);
+}
+
+TEST(MuFormat, UnitsFormatterDefault) {
+  using u = mu::mult<apples, mu::pow<oranges, -2>>;
+  mu::detail::quantity_units_formatter<u> formatter;
+  std::string out = "3";
+  formatter.format(std::back_inserter(out));
+  ASSERT_EQ(out, "3 apples * oranges^-2");
+}
+
+TEST(MuFormat, UnitsFormatterAllOptions) {
+  using u = mu::mult<apples, mu::pow<oranges, 2>>;
+  mu::detail::quantity_units_formatter<u> formatter;
+  auto spec = formatter.parse(".3f;sym;sup; • ");
+  ASSERT_EQ(spec.error, nullptr);
+  ASSERT_EQ(spec.value_spec, ".3f");
+  std::string out = "1.235";
+  formatter.format(std::back_inserter(out));
+  ASSERT_EQ(out, "1.235 🍎 • 🍊²");
+}
+
+TEST(MuFormat, UnitsFormatterSimplified) {
+  using u = mu::mult<apples, oranges, apples>;
+  mu::detail::quantity_units_formatter<u> formatter;
+  formatter.parse(";simp;x");
+  std::string out = "7";
+  formatter.format(std::back_inserter(out));
+  ASSERT_EQ(out, "7 apples^2xoranges");
+}
+
+TEST(MuFormat, UnitsFormatterInvalidSpec) {
+  mu::detail::quantity_units_formatter<apples> formatter;
+  formatter.parse(";sym");
+  ASSERT_NE(formatter.parse(";symbol;x").error, nullptr);
+  std::string out = "4";
+  formatter.format(std::back_inserter(out));
+  ASSERT_EQ(out, "4 🍎");
+}
+
+CONSTEXPR_TEST(MuFormat, UnitsFormatterConstexpr) {
+  constexpr bool check_format() {
+    mu::detail::quantity_units_formatter<mu::pow<apples, 3>> formatter;
+    formatter.parse(";sup");
+    std::array<char, 16> chars{};
+    auto end = formatter.format(chars.begin());
+    return std::string_view(chars.begin(), end) == " apples³";
+  }
+  static_assert(check_format());
+}
+
+// `std::formatter` is only tested by standard libraries that implement
+// `std::format`. Otherwise, `quantity_units_formatter` above formats the units.
+#if defined(__cpp_lib_format)
+
+TEST(MuFormat, Default) {
+  auto q = 3 * apples{} * mu::pow<oranges, -2>{};
+  ASSERT_EQ(std::format("{}", q), "3 apples * oranges^-2");
+}
+
+TEST(MuFormat, AllOptions) {
+  mu::quantity<double, mu::mult<apples, mu::pow<oranges, 2>>> q{1.23456};
+  ASSERT_EQ(std::format("{:.3f;sym;sup; • }", q), "1.235 🍎 • 🍊²");
+}
+
+TEST(MuFormat, ValueWidth) {
+  auto q = 42 * apples{};
+  ASSERT_EQ(std::format("[{:>5;sym}]", q), "[   42 🍎]");
+}
+
+TEST(MuFormat, FormatTo) {
+  auto q = 7 * apples{} * basket{} * oranges{};
+  std::string out;
+  std::format_to(std::back_inserter(out), "{:;;x}", q);
+  ASSERT_EQ(out, "7 applesxbasket_of_oranges");
+}
+
+#endif
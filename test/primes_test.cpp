@@ -69,4 +69,53 @@ TEST(MuPrimes, FactorsOf10Over7ToThe2Over3) {
   std::vector<prime_factor> expected = {{2, {2, 3}}, {5, {2, 3}}, {7, {-2, 3}}};
   std::vector<prime_factor> actual = prime_factorize(value, exponent);
   ASSERT_EQ(actual, expected);
-}
\ No newline at end of file
+}
+
+TEST(MuPrimes, CombineInPlace) {
+  mu::detail::static_vector<prime_factor,
+                            mu::detail::MAX_PRIME_FACTORS_PER_RATIO * 2>
+      actual;
+  mu::detail::prime_factorize(actual, ratio{-12, 5}, 1);
+  mu::detail::prime_factorize(actual, ratio{10, 3}, 1);
+  mu::detail::combine_prime_factors(actual);
+  std::vector<prime_factor> expected = {{-1, 1}, {2, 3}};
+  ASSERT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(MuPrimes, MaxDistinctPrimeFactors) {
+  // 2 * 3 * 5 * ... * 47 fits in 64 bits, but also multiplying by 53 does not.
+  if constexpr (sizeof(std::intmax_t) == 8) {
+    ASSERT_EQ(mu::detail::MAX_DISTINCT_PRIME_FACTORS, 15);
+  }
+}
+
+TEST(MuPrimes, SharedRatioFactors) {
+  const auto &actual = mu::detail::ratio_prime_factors<-60, 7>;
+  std::vector<prime_factor> expected = {
+      {-1, 1}, {2, 2}, {3, 1}, {5, 1}, {7, -1}};
+  ASSERT_TRUE(std::equal(actual.begin(), actual.end(), expected.begin(),
+                         expected.end()));
+}
+
+TEST(MuPrimes, FactorsOfProductOfLargePrimes) {
+  // Both primes are beyond the primes table.
+  ratio value{4294967291LL * 2147483647LL, 6 * 1000003};
+  std::vector<prime_factor> expected = {{2147483647, 1},
+                                        {4294967291, 1},
+                                        {2, -1},
+                                        {3, -1},
+                                        {1000003, -1}};
+  std::vector<prime_factor> actual = prime_factorize(value);
+  ASSERT_EQ(actual, expected);
+  static_assert(prime_factors_equal(ratio{999983LL * 1000003LL * 1000033LL}, 1,
+                                    {{999983, 1}, {1000003, 1}, {1000033, 1}}));
+}
+
+TEST(MuPrimes, FactorsOfSquareOfLargePrime) {
+  constexpr ratio value = 3037000493LL * 3037000493LL;
+  std::vector<prime_factor> expected = {{3037000493, 2}};
+  std::vector<prime_factor> actual = prime_factorize(value);
+  ASSERT_EQ(actual, expected);
+  static_assert(prime_factors_equal(value, 1, {{3037000493, 2}}));
+}
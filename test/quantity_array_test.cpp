@@ -0,0 +1,105 @@
+#include "mu_test.hpp"
+#include <cstdint>
+#include <mu/units/si_units.hpp>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace /* local to this file only */ {
+
+template <class T> bool is_aligned(const T *ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+} // namespace
+
+CONSTEXPR_TEST(MuQuantityArray, MoveOnly) {
+  using array = mu::quantity_array<double, mu::meter>;
+  static_assert(!std::is_copy_constructible_v<array>);
+  static_assert(!std::is_copy_assignable_v<array>);
+  static_assert(std::is_nothrow_move_constructible_v<array>);
+  static_assert(std::is_nothrow_move_assignable_v<array>);
+  static_assert(std::ranges::contiguous_range<array>);
+}
+
+TEST(MuQuantityArray, ValueInitialized) {
+  mu::quantity_array<int, apples> a(5);
+  ASSERT_EQ(a.size(), 5);
+  ASSERT_FALSE(a.empty());
+  for (const auto &q : a) {
+    ASSERT_EQ(q.value(), 0);
+  }
+
+  mu::quantity_array<int, apples> b(3, mu::quantity<int, apples>{7});
+  ASSERT_EQ(b[0].value(), 7);
+  ASSERT_EQ(b[2].value(), 7);
+
+  mu::quantity_array<int, apples> empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(empty.data(), nullptr);
+  ASSERT_TRUE(empty.reps().empty());
+}
+
+TEST(MuQuantityArray, Alignment) {
+  mu::quantity_array<float, mu::meter> a(3);
+  ASSERT_TRUE(is_aligned(a.data(), 64));
+
+  using aligned_128 = mu::aligned_allocator<std::int16_t, 128>;
+  mu::quantity_array<std::int16_t, mu::meter, aligned_128> b(3);
+  ASSERT_TRUE(is_aligned(b.data(), 128));
+  ASSERT_TRUE(is_aligned(b.reps().data(), 128));
+
+  mu::quantity_array<double, mu::meter, std::allocator<double>> c(3);
+  ASSERT_TRUE(is_aligned(c.data(), alignof(double)));
+}
+
+TEST(MuQuantityArray, Reps) {
+  mu::quantity_array<double, mu::meter> a(3);
+  const std::span<double> reps = a.reps();
+  ASSERT_EQ(reps.size(), 3);
+  reps[1] = 2.5;
+  ASSERT_EQ(a[1].value(), 2.5);
+  a[2] = mu::quantity<double, mu::meter>{-1.0};
+  ASSERT_EQ(std::as_const(a).reps()[2], -1.0);
+}
+
+TEST(MuQuantityArray, ConvertingConstruction) {
+  const std::vector<mu::quantity<int, mu::kilometer>> km{
+      mu::quantity<int, mu::kilometer>{1},
+      mu::quantity<int, mu::kilometer>{-2}};
+  const mu::quantity_array<int, mu::kilometer> a(km);
+  ASSERT_EQ(a.size(), 2);
+  ASSERT_EQ(a[1].value(), -2);
+
+  const mu::quantity_array<double, mu::meter> m(a);
+  ASSERT_EQ(m.size(), 2);
+  ASSERT_DOUBLE_EQ(m[0].value(), 1000.0);
+  ASSERT_DOUBLE_EQ(m[1].value(), -2000.0);
+
+  // Copies of the same type are made from a span.
+  const mu::quantity_array<int, mu::kilometer> copy(std::span{a});
+  ASSERT_NE(copy.data(), a.data());
+  ASSERT_EQ(copy[0].value(), 1);
+
+  using int_meters = mu::quantity_array<int, mu::meter>;
+  using double_meters = mu::quantity_array<double, mu::meter>;
+  using int_seconds = mu::quantity_array<int, mu::second>;
+  static_assert(
+      !std::is_constructible_v<int_meters, const double_meters &>);
+  static_assert(!std::is_constructible_v<int_seconds, const int_meters &>);
+}
+
+TEST(MuQuantityArray, Move) {
+  mu::quantity_array<int, apples> a(4, mu::quantity<int, apples>{3});
+  const auto *data = a.data();
+  mu::quantity_array<int, apples> b(std::move(a));
+  ASSERT_EQ(b.data(), data);
+  ASSERT_EQ(b.size(), 4);
+  ASSERT_TRUE(a.empty());
+
+  mu::quantity_array<int, apples> c(2);
+  c = std::move(b);
+  ASSERT_EQ(c.data(), data);
+  ASSERT_TRUE(b.empty());
+}
@@ -0,0 +1,104 @@
+#include "mu_test.hpp"
+#include <array>
+#include <cstdint>
+#include <mu/units/si_units.hpp>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+CONSTEXPR_TEST(MuQuantitySpan, LayoutCompatible) {
+  using mu::detail::layout_compatible_quantity;
+  static_assert(layout_compatible_quantity<double, mu::meter>);
+  static_assert(layout_compatible_quantity<std::int8_t, apples>);
+  static_assert(std::ranges::contiguous_range<
+                mu::quantity_span<double, mu::meter>>);
+  static_assert(std::ranges::borrowed_range<
+                mu::quantity_span<const double, mu::meter>>);
+  static_assert(std::ranges::view<mu::quantity_span<double, mu::meter>>);
+  static_assert(sizeof(mu::quantity_span<double, mu::meter, 4>) ==
+                sizeof(std::span<double>));
+}
+
+TEST(MuQuantitySpan, ViewsWithoutCopy) {
+  std::vector<double> buffer{1.0, 2.0, 3.0};
+  mu::quantity_span<double, mu::meter> meters{buffer};
+  ASSERT_EQ(meters.size(), 3);
+  ASSERT_EQ(meters.size_bytes(), 3 * sizeof(double));
+  ASSERT_EQ(static_cast<const void *>(meters.data()),
+            static_cast<const void *>(buffer.data()));
+  ASSERT_EQ(meters[1].value(), 2.0);
+
+  meters[2] = mu::quantity<double, mu::meter>{5.0};
+  ASSERT_EQ(buffer[2], 5.0);
+  buffer[0] = -1.0;
+  ASSERT_EQ(meters.front().value(), -1.0);
+  ASSERT_EQ(meters.back().value(), 5.0);
+  ASSERT_EQ(meters.reps().data(), buffer.data());
+
+  double sum = 0.0;
+  for (mu::quantity<double, mu::meter> m : meters) {
+    sum += m.value();
+  }
+  ASSERT_EQ(sum, 6.0);
+}
+
+TEST(MuQuantitySpan, ConstAndStaticExtent) {
+  const std::array<std::int32_t, 4> raw{1, 2, 3, 4};
+  const mu::quantity_span<const std::int32_t, mu::second, 4> fixed{
+      std::span{raw}};
+  static_assert(decltype(fixed)::extent == 4);
+  static_assert(
+      std::is_same_v<decltype(fixed[0]),
+                     const mu::quantity<std::int32_t, mu::second> &>);
+  ASSERT_EQ(fixed[3].value(), 4);
+
+  // Converts to a dynamic extent.
+  const mu::quantity_span<const std::int32_t, mu::second> dynamic{fixed};
+  ASSERT_EQ(dynamic.size(), 4);
+
+  // Converts from mutable to const.
+  std::array<std::int32_t, 2> mutable_raw{7, 8};
+  const mu::quantity_span<std::int32_t, mu::second> mutable_view{
+      mutable_raw.data(), mutable_raw.size()};
+  const mu::quantity_span<const std::int32_t, mu::second> const_view{
+      mutable_view};
+  ASSERT_EQ(const_view[1].value(), 8);
+  static_assert(
+      !std::is_constructible_v<mu::quantity_span<std::int32_t, mu::second>,
+                               mu::quantity_span<const std::int32_t,
+                                                 mu::second>>);
+}
+
+TEST(MuQuantitySpan, Subspans) {
+  std::array<int, 5> raw{0, 1, 2, 3, 4};
+  const mu::quantity_span<int, apples> all{std::span{raw}};
+  ASSERT_EQ(all.first(2).size(), 2);
+  ASSERT_EQ(all.first(2)[1].value(), 1);
+  ASSERT_EQ(all.last(2)[0].value(), 3);
+  ASSERT_EQ(all.subspan(1, 3).back().value(), 3);
+  ASSERT_EQ(all.subspan(3).size(), 2);
+  ASSERT_TRUE((mu::quantity_span<int, apples>{}.empty()));
+}
+
+TEST(MuQuantitySpan, LazyConversion) {
+  std::vector<std::int32_t> raw{1500, -250};
+  const mu::quantity_span<std::int32_t, mu::millisecond> ms{raw};
+  auto seconds = ms.as<double, mu::second>();
+  static_assert(std::ranges::random_access_range<decltype(seconds)>);
+  ASSERT_EQ(seconds.size(), 2);
+  ASSERT_DOUBLE_EQ(seconds[0].value(), 1.5);
+
+  // Nothing is copied, so later writes to the buffer are visible.
+  raw[1] = 3000;
+  ASSERT_DOUBLE_EQ(seconds[1].value(), 3.0);
+}
+
+TEST(MuQuantitySpan, BulkConversion) {
+  std::vector<float> mm{250.0f, 500.0f};
+  std::vector<float> m(2);
+  mu::convert(mu::quantity_span<const float, mu::millimeter>{mm},
+              mu::quantity_span<float, mu::meter>{m});
+  ASSERT_FLOAT_EQ(m[0], 0.25f);
+  ASSERT_FLOAT_EQ(m[1], 0.5f);
+}
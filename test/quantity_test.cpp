@@ -1,4 +1,7 @@
 #include "mu_test.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
 
 TEST(MuQuantity, ConstructIntApplesFromValue) {
   mu::quantity<int, apples> a{5};
@@ -72,6 +75,69 @@ TEST(MuQuantity, MoveCastIntApplesToIntKiloApples) {
   ASSERT_EQ(b.value(), 5);
 }
 
+TEST(MuQuantity, CastIntApplesToIntKiloApplesWithRounding) {
+  using kilo_apples = mu::mult<std::kilo, apples>;
+  using mu::rounding;
+  for (auto [value, truncated, floor, ceil, nearest] :
+       {std::array{5400, 5, 5, 6, 5}, std::array{5500, 5, 5, 6, 6},
+        std::array{-5500, -5, -6, -5, -6}, std::array{-5400, -5, -6, -5, -5},
+        std::array{-6000, -6, -6, -6, -6}}) {
+    mu::quantity<int, apples> a{value};
+    ASSERT_EQ((mu::quantity_cast<int, kilo_apples, rounding::truncate>(a)
+                   .value()),
+              truncated);
+    ASSERT_EQ(
+        (mu::quantity_cast<int, kilo_apples, rounding::floor>(a).value()),
+        floor);
+    ASSERT_EQ((mu::quantity_cast<int, kilo_apples, rounding::ceil>(a).value()),
+              ceil);
+    ASSERT_EQ(
+        (mu::quantity_cast<int, kilo_apples, rounding::nearest>(a).value()),
+        nearest);
+  }
+}
+
+CONSTEXPR_TEST(MuQuantity, CastLargeIntMillisecondsToSecondsExactly) {
+  // The result needs more precision than a double has.
+  constexpr mu::quantity<std::int64_t, mu::millisecond> ms{
+      9'007'199'254'740'993'000};
+  static_assert(mu::quantity_cast<std::int64_t, mu::second>(ms).value() ==
+                9'007'199'254'740'993);
+  static_assert(
+      mu::quantity_cast<std::int64_t, mu::minute, mu::rounding::ceil>(ms)
+          .value() == 150'119'987'579'017);
+}
+
+CONSTEXPR_TEST(MuQuantity, CastIntByRatioWithRounding) {
+  // 7 minutes is 420/3600 hours, or 0.11666...
+  constexpr mu::quantity<int, mu::minute> min{7};
+  using mu::rounding;
+  static_assert(mu::quantity_cast<int, mu::hour>(min).value() == 0);
+  static_assert(
+      mu::quantity_cast<int, mu::hour, rounding::ceil>(min).value() == 1);
+  static_assert(
+      mu::quantity_cast<unsigned, mu::hour, rounding::nearest>(
+          mu::quantity<unsigned, mu::minute>{30})
+          .value() == 1);
+  static_assert(
+      mu::quantity_cast<int, mu::hour, rounding::nearest>(
+          mu::quantity<int, mu::minute>{-29})
+          .value() == 0);
+}
+
+TEST(MuQuantity, CastDoubleToIntWithRounding) {
+  using mu::rounding;
+  mu::quantity<double, apples> a{-2.5};
+  ASSERT_EQ((mu::quantity_cast<int, apples>(a).value()), -2);
+  ASSERT_EQ((mu::quantity_cast<int, apples, rounding::floor>(a).value()), -3);
+  ASSERT_EQ((mu::quantity_cast<int, apples, rounding::ceil>(a).value()), -2);
+  ASSERT_EQ((mu::quantity_cast<int, apples, rounding::nearest>(a).value()),
+            -3);
+  mu::quantity<double, mu::mult<std::milli, apples>> b{1499.0};
+  ASSERT_EQ((mu::quantity_cast<int, apples, rounding::nearest>(b).value()), 1);
+  ASSERT_EQ((mu::quantity_cast<int, apples, rounding::ceil>(b).value()), 2);
+}
+
 TEST(MuQuantity, AddIntApplesToIntApples) {
   mu::quantity<int, apples> a{12};
   mu::quantity<int, apples> b{55};
@@ -194,4 +260,115 @@ TEST(MuQuantity, ConstructFromReferences) {
 
   auto f = c / oranges{};
   ASSERT_EQ(f, a);
-}
\ No newline at end of file
+}
+
+TEST(MuQuantity, AddIntKiloApplesToIntApples) {
+  mu::quantity<int, mu::mult<std::kilo, apples>> a{2};
+  mu::quantity<int, apples> b{5};
+  // Kiloapples are widened, since 1000 times an int may not fit in an int.
+  auto c = a + b;
+  static_assert(
+      std::is_same_v<decltype(c), mu::quantity<std::intmax_t, apples>>);
+  ASSERT_EQ(c.value(), 2005);
+  auto d = b - a;
+  static_assert(
+      std::is_same_v<decltype(d), mu::quantity<std::intmax_t, apples>>);
+  ASSERT_EQ(d.value(), -1995);
+}
+
+TEST(MuQuantity, AddIntApplesByRatioOfIntegers) {
+  // The common units of 2 apples and 3 apples are single apples.
+  using two_apples = mu::mult<std::ratio<2>, apples>;
+  using three_apples = mu::mult<std::ratio<3>, apples>;
+  mu::quantity<int, two_apples> a{4};
+  mu::quantity<int, three_apples> b{1};
+  auto c = a + b;
+  using common = mu::detail::common_units_t<two_apples, three_apples>;
+  static_assert(
+      std::is_same_v<decltype(c), mu::quantity<std::intmax_t, common>>);
+  static_assert(mu::units_equivalent_to<common, apples>);
+  ASSERT_EQ(c.value(), 11);
+}
+
+TEST(MuQuantity, AddIrrationallyScaledApples) {
+  using sqrt_2_apples = mu::mult<mu::pow<std::ratio<2>, 1, 2>, apples>;
+  mu::quantity<int, apples> a{1};
+  mu::quantity<int, sqrt_2_apples> b{2};
+  auto c = a + b;
+  static_assert(std::is_same_v<decltype(c), mu::quantity<double, apples>>);
+  ASSERT_NEAR(c.value(), 1 + 2 * 1.4142135623730951, 1e-12);
+}
+
+CONSTEXPR_TEST(MuQuantity, CompareMixedUnits) {
+  constexpr mu::quantity<std::int64_t, mu::millisecond> ms{1500};
+  constexpr mu::quantity<std::int32_t, mu::second> s{1};
+  static_assert(ms > s);
+  static_assert(ms >= s);
+  static_assert(s < ms);
+  static_assert(s <= ms);
+  static_assert(ms != s);
+  static_assert(!(ms == s));
+  static_assert(mu::quantity<int, mu::minute>{2} ==
+                mu::quantity<int, mu::second>{120});
+  static_assert(mu::quantity<int, mu::minute>{2} <
+                mu::quantity<int, mu::hour>{1});
+}
+
+CONSTEXPR_TEST(MuQuantity, CommonType) {
+  using km = mu::quantity<int, mu::kilometer>;
+  using m = mu::quantity<double, mu::meter>;
+  using mm = mu::quantity<short, mu::millimeter>;
+  static_assert(std::is_same_v<std::common_type_t<km, m>,
+                               mu::quantity<double, mu::meter>>);
+  static_assert(std::is_same_v<std::common_type_t<km, mm>,
+                               mu::quantity<std::intmax_t, mu::millimeter>>);
+  static_assert(std::is_same_v<std::common_type_t<km, km>, km>);
+  static_assert(
+      std::is_same_v<std::common_type_t<mu::quantity<int, mu::minute>,
+                                        mu::quantity<int, mu::hour>>,
+                     mu::quantity<std::intmax_t, mu::minute>>);
+  static_assert(
+      std::is_same_v<std::common_type_t<mu::quantity<std::int8_t, mu::minute>,
+                                        mu::quantity<std::int8_t, mu::hour>>,
+                     mu::quantity<int, mu::minute>>);
+}
+
+CONSTEXPR_TEST(MuQuantity, MixedUnitsNearRepLimits) {
+  // 3001 km is 3.001e9 mm, which does not fit in an int.
+  constexpr mu::quantity<int, mu::kilometer> km{3001};
+  constexpr mu::quantity<int, mu::millimeter> mm{5};
+  static_assert(km > mm);
+  static_assert(mm < km);
+  static_assert(km != mm);
+  static_assert((km + mm).value() == 3'001'000'005);
+  static_assert((mm - km).value() == -3'000'999'995);
+
+  constexpr int max = std::numeric_limits<int>::max();
+  constexpr int min = std::numeric_limits<int>::min();
+  static_assert(mu::quantity<int, mu::kilometer>{max} ==
+                mu::quantity<std::int64_t, mu::millimeter>{
+                    std::int64_t{max} * 1'000'000});
+  static_assert(mu::quantity<int, mu::kilometer>{min} <
+                mu::quantity<int, mu::millimeter>{min});
+  static_assert((mu::quantity<int, mu::hour>{max} -
+                 mu::quantity<int, mu::minute>{min})
+                    .value() == std::int64_t{max} * 60 - min);
+
+  constexpr std::uint32_t umax = std::numeric_limits<std::uint32_t>::max();
+  constexpr auto sum = mu::quantity<std::uint32_t, mu::kilometer>{umax} +
+                       mu::quantity<std::uint32_t, mu::meter>{1};
+  static_assert(std::is_same_v<decltype(sum),
+                               const mu::quantity<std::uintmax_t, mu::meter>>);
+  static_assert(sum.value() == std::uintmax_t{umax} * 1000 + 1);
+}
+
+CONSTEXPR_TEST(MuQuantity, WidenBeforeIntegerScale) {
+  // 3000 km is 3e9 mm, which overflows the source rep but not the destination.
+  constexpr mu::quantity<std::int32_t, mu::kilometer> km{3000};
+  constexpr mu::quantity<std::int64_t, mu::millimeter> mm = km;
+  static_assert(mm.value() == 3'000'000'000);
+  static_assert(mu::quantity_cast<std::int64_t, mu::millimeter>(km).value() ==
+                3'000'000'000);
+  static_assert(mu::quantity_cast<std::uint32_t, mu::millimeter>(km).value() ==
+                3'000'000'000u);
+}
@@ -0,0 +1,160 @@
+#include "mu_test.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <mu/units/si_units.hpp>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using mu::summation;
+
+CONSTEXPR_TEST(MuReduce, ConstantEvaluated) {
+  constexpr std::array<mu::quantity<int, mu::meter>, 5> m{
+      mu::quantity<int, mu::meter>{3}, mu::quantity<int, mu::meter>{-1},
+      mu::quantity<int, mu::meter>{4}, mu::quantity<int, mu::meter>{1},
+      mu::quantity<int, mu::meter>{-5}};
+  static_assert(mu::reduce::sum(m).value() == 2);
+  static_assert(mu::reduce::mean(m).value() == 0);
+  static_assert(mu::reduce::min(m).value() == -5);
+  static_assert(mu::reduce::max(m).value() == 4);
+  static_assert(mu::reduce::sum_of_squares(m).value() == 52);
+  static_assert(mu::reduce::dot(m, m).value() == 52);
+}
+
+CONSTEXPR_TEST(MuReduce, ResultUnits) {
+  using meters = std::vector<mu::quantity<double, mu::meter>>;
+  using newtons = std::vector<mu::quantity<float, mu::newton>>;
+  static_assert(std::is_same_v<decltype(mu::reduce::sum(meters{})),
+                               mu::quantity<double, mu::meter>>);
+  static_assert(std::is_same_v<decltype(mu::reduce::min(meters{})),
+                               mu::quantity<double, mu::meter>>);
+  static_assert(std::is_same_v<decltype(mu::reduce::norm(meters{})),
+                               mu::quantity<double, mu::meter>>);
+  static_assert(
+      std::is_same_v<decltype(mu::reduce::dot(newtons{}, meters{})),
+                     decltype(mu::quantity<float, mu::newton>{} *
+                              mu::quantity<double, mu::meter>{})>);
+  static_assert(std::is_same_v<decltype(mu::reduce::sum_of_squares(meters{})),
+                               decltype(mu::quantity<double, mu::meter>{} *
+                                        mu::quantity<double, mu::meter>{})>);
+  static_assert(mu::quantity_losslessly_convertible_to<
+                double,
+                decltype(mu::reduce::sum_of_squares(meters{}))::units_type,
+                double, mu::pow<mu::meter, 2>>);
+  static_assert(mu::quantity_losslessly_convertible_to<
+                double,
+                decltype(mu::reduce::dot(newtons{}, meters{}))::units_type,
+                double, mu::joule>);
+
+  // Small integers are promoted, as they are by operator+.
+  using bytes = std::vector<mu::quantity<std::int8_t, apples>>;
+  static_assert(std::is_same_v<decltype(mu::reduce::sum(bytes{})),
+                               mu::quantity<int, apples>>);
+  static_assert(std::is_same_v<decltype(mu::reduce::max(bytes{})),
+                               mu::quantity<std::int8_t, apples>>);
+}
+
+TEST(MuReduce, EmptyRange) {
+  const std::vector<mu::quantity<double, mu::second>> empty;
+  ASSERT_EQ(mu::reduce::sum(empty).value(), 0.0);
+  ASSERT_EQ(mu::reduce::sum<summation::compensated>(empty).value(), 0.0);
+  ASSERT_EQ(mu::reduce::dot(empty, empty).value(), 0.0);
+  ASSERT_EQ(mu::reduce::norm(empty).value(), 0.0);
+}
+
+TEST(MuReduce, EveryLengthMatchesLoop) {
+  // Cover lengths around the lane count and the pairwise block size.
+  std::vector<mu::quantity<double, mu::meter>> m;
+  double expected_sum = 0.0;
+  double expected_squares = 0.0;
+  double expected_min = 0.0;
+  double expected_max = 0.0;
+  for (int i = 0; i < 300; ++i) {
+    const double value = (i % 7) - 3.0 + 0.25 * i;
+    m.push_back(mu::quantity<double, mu::meter>{value});
+    expected_sum += value;
+    expected_squares += value * value;
+    expected_min = i == 0 ? value : std::min(expected_min, value);
+    expected_max = i == 0 ? value : std::max(expected_max, value);
+
+    const std::span<const mu::quantity<double, mu::meter>> prefix{m};
+    ASSERT_EQ(mu::reduce::sum(prefix).value(), expected_sum);
+    ASSERT_EQ(mu::reduce::sum<summation::compensated>(prefix).value(),
+              expected_sum);
+    ASSERT_EQ(mu::reduce::sum_of_squares(prefix).value(), expected_squares);
+    ASSERT_EQ(mu::reduce::mean(prefix).value(), expected_sum / m.size());
+    ASSERT_EQ(mu::reduce::min(prefix).value(), expected_min);
+    ASSERT_EQ(mu::reduce::max(prefix).value(), expected_max);
+  }
+}
+
+TEST(MuReduce, SummationAccuracy) {
+  // A large value followed by many values below its precision. Adding them in
+  // order loses every small value.
+  using seconds = mu::quantity<float, mu::second>;
+  std::vector<seconds> s(1 << 20, seconds{1.0f});
+  s[0] = seconds{1e8f};
+  const double expected = 1e8 + (s.size() - 1);
+
+  float naive = 0.0f;
+  for (auto value : s) {
+    naive += value.value();
+  }
+  ASSERT_EQ(naive, 1e8f);
+
+  const double pairwise = mu::reduce::sum(s).value();
+  const double compensated =
+      mu::reduce::sum<summation::compensated>(s).value();
+  ASSERT_NEAR(pairwise, expected, 64.0);
+  ASSERT_EQ(compensated, static_cast<float>(expected));
+}
+
+TEST(MuReduce, CompensatedCancellation) {
+  const std::vector<mu::quantity<double, apples>> a{
+      mu::quantity<double, apples>{1.0}, mu::quantity<double, apples>{1e100},
+      mu::quantity<double, apples>{1.0}, mu::quantity<double, apples>{-1e100}};
+  ASSERT_EQ(mu::reduce::sum<summation::compensated>(a).value(), 2.0);
+}
+
+TEST(MuReduce, DotAndNorm) {
+  const std::vector<mu::quantity<double, mu::newton>> force{
+      mu::quantity<double, mu::newton>{3.0},
+      mu::quantity<double, mu::newton>{4.0}};
+  const std::vector<mu::quantity<double, mu::meter>> displacement{
+      mu::quantity<double, mu::meter>{2.0},
+      mu::quantity<double, mu::meter>{-0.5}};
+  const mu::quantity<double, mu::joule> work =
+      mu::reduce::dot(force, displacement);
+  ASSERT_EQ(work.value(), 4.0);
+  ASSERT_EQ(mu::reduce::norm(force).value(), 5.0);
+
+  const std::vector<mu::quantity<int, mu::meter>> ints{
+      mu::quantity<int, mu::meter>{3}, mu::quantity<int, mu::meter>{4}};
+  const auto root = mu::reduce::norm(ints);
+  static_assert(std::is_same_v<decltype(root),
+                               const mu::quantity<double, mu::meter>>);
+  ASSERT_EQ(root.value(), 5.0);
+}
+
+TEST(MuReduce, DotSizeMismatch) {
+  const std::vector<mu::quantity<double, apples>> a(3);
+  const std::vector<mu::quantity<double, oranges>> b(2);
+  ASSERT_THROW(mu::reduce::dot(a, b), std::length_error);
+}
+
+TEST(MuReduce, QuantityArrayAndSpan) {
+  mu::quantity_array<double, mu::kilogram> masses(10);
+  for (std::size_t i = 0; i < masses.size(); ++i) {
+    masses[i] = mu::quantity<double, mu::kilogram>{static_cast<double>(i)};
+  }
+  ASSERT_EQ(mu::reduce::sum(masses).value(), 45.0);
+
+  std::array<float, 4> raw{2.0f, -8.0f, 6.0f, 4.0f};
+  const mu::quantity_span<const float, mu::second> seconds{raw};
+  ASSERT_EQ(mu::reduce::max(seconds).value(), 6.0f);
+  ASSERT_EQ(mu::reduce::min(seconds).value(), -8.0f);
+  ASSERT_EQ(mu::reduce::mean(seconds).value(), 1.0f);
+}
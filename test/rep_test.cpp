@@ -121,4 +121,60 @@ CONSTEXPR_TEST(MuRep, CustomRepLossilyScalable) {
 CONSTEXPR_TEST(MuRep, CustomRepNotLossilyScalable) {
   static_assert(!mu::rep_lossily_scalable_to<myvec4d, myvec3d, float>);
   static_assert(!mu::rep_lossily_scalable_to<myvec4d, myvec3i, int>);
-}
\ No newline at end of file
+}
+
+CONSTEXPR_TEST(MuRep, RelaxedScaleTypes) {
+  using mu::detail::relaxed_scale_t;
+
+  // Integer scales are never relaxed.
+  static_assert(std::is_same_v<relaxed_scale_t<double, int, int>, int>);
+
+  // Floating-point reps are scaled by their own type.
+  static_assert(
+      std::is_same_v<relaxed_scale_t<int, float, long double>, float>);
+  static_assert(
+      std::is_same_v<relaxed_scale_t<float, double, long double>, double>);
+  static_assert(std::is_same_v<relaxed_scale_t<myvec3i, myvec3d, long double>,
+                               double>);
+
+  // Integer reps are scaled by the narrowest type that holds both reps.
+  static_assert(std::is_same_v<
+                relaxed_scale_t<std::int16_t, std::int16_t, long double>,
+                float>);
+  static_assert(std::is_same_v<
+                relaxed_scale_t<std::int32_t, std::int16_t, long double>,
+                double>);
+  static_assert(
+      std::is_same_v<relaxed_scale_t<float, std::int32_t, long double>,
+                     double>);
+  static_assert(
+      std::is_same_v<relaxed_scale_t<double, std::int8_t, long double>,
+                     double>);
+  static_assert(std::is_same_v<
+                relaxed_scale_t<std::int64_t, std::int32_t, long double>,
+                mu::detail::exact_float_t<std::int64_t>>);
+}
+
+/// A rep that overrides the type of its scales.
+struct coarse_rep {
+  double value;
+  constexpr coarse_rep operator*(float scale) const {
+    return {value * scale};
+  }
+};
+
+template <> struct mu::rep_traits<coarse_rep> {
+  using base_rep_type = double;
+  using scale_type = float;
+  constexpr static coarse_rep lossless_cast(coarse_rep value) { return value; }
+  constexpr static coarse_rep lossy_cast(coarse_rep value) { return value; }
+};
+
+CONSTEXPR_TEST(MuRep, CustomScaleType) {
+  using mu::detail::relaxed_scale_t;
+  static_assert(mu::rep<coarse_rep>);
+  static_assert(std::is_same_v<
+                relaxed_scale_t<coarse_rep, coarse_rep, long double>, float>);
+  static_assert(mu::rep_losslessly_scalable_to<coarse_rep, coarse_rep,
+                                               long double>);
+}
@@ -0,0 +1,59 @@
+#include "mu_test.hpp"
+
+using mu::detail::ratio;
+using mu::detail::units_signature_object;
+
+CONSTEXPR_TEST(MuSignature, Empty) {
+  constexpr const auto &s = units_signature_object<mu::mult<>>;
+  static_assert(s.terms.size() == 0);
+  static_assert(s.primes.size() == 0);
+}
+
+CONSTEXPR_TEST(MuSignature, CombineByBase) {
+  using u = mu::mult<apples, oranges, mu::pow<apples, 2>, mu::per<oranges>>;
+  constexpr const auto &s = units_signature_object<u>;
+  static_assert(s.terms.size() == 2);
+  static_assert(s.terms[0].exponent == ratio{3});
+  static_assert(s.terms[1].exponent.is_zero());
+  static_assert(s.terms[0].base_type_id == mu::detail::type_id<apples>);
+  static_assert(s.terms[1].base_type_id == mu::detail::type_id<oranges>);
+}
+
+CONSTEXPR_TEST(MuSignature, HashOrder) {
+  using u = mu::mult<apples, oranges, golden, funky>;
+  constexpr const auto &s = units_signature_object<u>;
+  static_assert(s.hash_order.size() == 4);
+  static_assert(std::is_sorted(s.hash_order.begin(), s.hash_order.end(),
+                               [](std::size_t lhs, std::size_t rhs) {
+                                 return s.terms[lhs].base_hash <
+                                        s.terms[rhs].base_hash;
+                               }));
+}
+
+CONSTEXPR_TEST(MuSignature, PrimeFactoredScale) {
+  using u = mu::mult<std::ratio<12>, apples, std::ratio<1, 2>, std::ratio<-5>>;
+  constexpr const auto &s = units_signature_object<u>;
+  // 12 * 1/2 * -5 = -1 * 2 * 3 * 5
+  static_assert(s.primes.size() == 4);
+  static_assert(s.primes[0].base == -1);
+  static_assert(s.primes[1].base == 2);
+  static_assert(s.primes[1].exponent == ratio{1});
+  static_assert(s.primes[2].base == 3);
+  static_assert(s.primes[3].base == 5);
+}
+
+CONSTEXPR_TEST(MuSignature, CancelledScale) {
+  using u = mu::mult<std::ratio<6>, std::ratio<1, 6>, apples>;
+  static_assert(units_signature_object<u>.primes.size() == 0);
+}
+
+CONSTEXPR_TEST(MuSignature, SameAnalysisEitherOrder) {
+  using a = mu::mult<mu::meter, mu::per<mu::minute>>;
+  using b = mu::mult<mu::meter, mu::per<mu::hour>>;
+  using mu::detail::analysis_object;
+  static_assert(analysis_object<a, b>.is_convertible);
+  static_assert(analysis_object<b, a>.is_convertible);
+  static_assert(analysis_object<a, b>.is_int_convertible);
+  static_assert(!analysis_object<b, a>.is_int_convertible);
+  static_assert(analysis_object<a, b>.int_conversion == 60);
+}
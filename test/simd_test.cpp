@@ -0,0 +1,154 @@
+#include "mu_test.hpp"
+#include <cstdint>
+#include <experimental/simd>
+#include <mu/simd.hpp>
+#include <mu/units/si_units.hpp>
+#include <type_traits>
+
+namespace stdx = std::experimental;
+
+using float8 = mu::vector_extension_t<float, 8>;
+using int4 = mu::vector_extension_t<std::int32_t, 4>;
+using float4 = mu::vector_extension_t<float, 4>;
+using short8 = mu::vector_extension_t<std::int16_t, 8>;
+
+CONSTEXPR_TEST(MuSimd, VectorExtensionReps) {
+  static_assert(mu::rep<float8>);
+  static_assert(mu::rep<int4>);
+  static_assert(mu::rep_traits<float8>::lane_count == 8);
+  static_assert(std::is_same_v<mu::rep_traits<int4>::base_rep_type,
+                               std::int32_t>);
+  static_assert(mu::detail::vector_rep<float8>);
+  static_assert(!mu::detail::vector_rep<float>);
+  static_assert(!mu::detail::vector_extension_rep<float[8]>);
+  static_assert(!mu::detail::vector_extension_rep<float *>);
+}
+
+CONSTEXPR_TEST(MuSimd, VectorExtensionCasts) {
+  static_assert(mu::rep_losslessly_castable_to<float, float8>);
+  static_assert(mu::rep_losslessly_castable_to<std::int16_t, float8>);
+  static_assert(!mu::rep_losslessly_castable_to<double, float8>);
+  static_assert(mu::rep_lossily_castable_to<double, float8>);
+  static_assert(!mu::rep_lossily_castable_to<double, int4>);
+
+  // Vectors convert lane by lane, if they have the same number of lanes.
+  static_assert(mu::rep_lossily_castable_to<int4, float4>);
+  static_assert(!mu::rep_losslessly_castable_to<int4, float4>);
+  static_assert(!mu::rep_lossily_castable_to<float4, int4>);
+  static_assert(!mu::rep_lossily_castable_to<int4, float8>);
+}
+
+CONSTEXPR_TEST(MuSimd, ScaleIsBroadcastAsLaneType) {
+  using mu::detail::relaxed_scale_t;
+  static_assert(std::is_same_v<relaxed_scale_t<float8, float8, long double>,
+                               float>);
+  static_assert(
+      std::is_same_v<relaxed_scale_t<float8, float8, std::int32_t>, float>);
+  static_assert(std::is_same_v<relaxed_scale_t<int4, int4, std::int16_t>,
+                               std::int32_t>);
+  static_assert(mu::quantity_losslessly_convertible_to<float8, mu::kilometer,
+                                                       float8, mu::meter>);
+  static_assert(mu::quantity_losslessly_convertible_to<int4, mu::kilometer,
+                                                       int4, mu::meter>);
+  static_assert(!mu::quantity_lossily_convertible_to<int4, mu::meter, int4,
+                                                     mu::kilometer>);
+}
+
+CONSTEXPR_TEST(MuSimd, LanesConvertAsScalars) {
+  using mu::detail::relaxed_scale_t;
+  // A million does not fit in an int16_t lane, so the scale is not relaxed.
+  static_assert(std::is_same_v<relaxed_scale_t<short8, short8, std::int32_t>,
+                               std::int32_t>);
+  static_assert(!std::is_convertible_v<mu::quantity<short8, mu::kilometer>,
+                                       mu::quantity<short8, mu::millimeter>>);
+  static_assert(
+      !std::is_convertible_v<mu::quantity<std::int16_t, mu::kilometer>,
+                             mu::quantity<std::int16_t, mu::millimeter>>);
+  static_assert(mu::quantity_lossily_convertible_to<short8, mu::kilometer,
+                                                    short8, mu::millimeter>);
+
+  // Scaling an int16_t by an integer promotes it to int, so no integer scale
+  // is lossless for int16_t lanes, as for an int16_t scalar.
+  static_assert(!mu::quantity_losslessly_convertible_to<short8, mu::kilometer,
+                                                        short8, mu::meter>);
+  static_assert(!mu::quantity_losslessly_convertible_to<
+                std::int16_t, mu::kilometer, std::int16_t, mu::meter>);
+}
+
+TEST(MuSimd, ConvertVectorExtension) {
+  const mu::quantity<float4, mu::millimeter> mm{float4{1.0f, 2.0f, 3.0f, 4.0f}};
+  const mu::quantity<float4, mu::meter> m =
+      mu::quantity_cast<float4, mu::meter>(mm);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_FLOAT_EQ(m.value()[i], 0.001f * (i + 1));
+  }
+
+  const mu::quantity<int4, mu::kilometer> km{int4{1, -2, 3, 40}};
+  const mu::quantity<int4, mu::meter> converted{km};
+  ASSERT_EQ(converted.value()[0], 1000);
+  ASSERT_EQ(converted.value()[1], -2000);
+  ASSERT_EQ(converted.value()[3], 40000);
+}
+
+TEST(MuSimd, VectorExtensionArithmetic) {
+  const mu::quantity<float4, mu::meter> distance{
+      float4{2.0f, 4.0f, 6.0f, 8.0f}};
+  const mu::quantity<float4, mu::second> time{float4{1.0f, 2.0f, 3.0f, 4.0f}};
+  const auto speed = distance / time;
+  static_assert(mu::quantity_losslessly_convertible_to<
+                float4, std::remove_cvref_t<decltype(speed)>::units_type,
+                float4, mu::mult<mu::meter, mu::pow<mu::second, -1>>>);
+  const auto doubled = (distance + distance) * 0.5f;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(speed.value()[i], 2.0f);
+    ASSERT_EQ(doubled.value()[i], distance.value()[i]);
+  }
+
+  // A scalar quantity is broadcast to every lane, and scaled on the way.
+  const mu::quantity<float4, mu::millimeter> broadcast{
+      mu::quantity<float, mu::meter>{3}};
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(broadcast.value()[i], 3000.0f);
+  }
+}
+
+TEST(MuSimd, ScaleWiderThanLanes) {
+  // Lanes keep the low bits of the scaled value, as an int16_t does.
+  const mu::quantity<short8, mu::kilometer> km{short8{3, -2, 1, 0, 7, 9, 4, 5}};
+  const auto mm = mu::quantity_cast<short8, mu::millimeter>(km);
+  for (int i = 0; i < 8; ++i) {
+    const mu::quantity<std::int16_t, mu::kilometer> lane{km.value()[i]};
+    ASSERT_EQ(mm.value()[i],
+              (mu::quantity_cast<std::int16_t, mu::millimeter>(lane).value()));
+  }
+}
+
+TEST(MuSimd, ExperimentalSimd) {
+  using simd_float = stdx::native_simd<float>;
+  using simd_int = stdx::rebind_simd_t<std::int32_t, simd_float>;
+  static_assert(mu::rep<simd_float>);
+  static_assert(mu::rep_traits<simd_float>::lane_count == simd_float::size());
+  static_assert(mu::rep_lossily_castable_to<simd_int, simd_float>);
+  static_assert(!mu::rep_lossily_castable_to<simd_float, simd_int>);
+  using simd_short = stdx::rebind_simd_t<std::int16_t, simd_float>;
+  static_assert(!std::is_convertible_v<mu::quantity<simd_short, mu::kilometer>,
+                                       mu::quantity<simd_short, mu::meter>>);
+
+  simd_float raw([](auto i) { return static_cast<float>(i + 1); });
+  const mu::quantity<simd_float, mu::kilometer> km{raw};
+  const mu::quantity<simd_float, mu::meter> m{km};
+  const auto area = m * m;
+  for (std::size_t i = 0; i < simd_float::size(); ++i) {
+    ASSERT_EQ(m.value()[i], 1000.0f * (i + 1));
+    ASSERT_EQ(area.value()[i], m.value()[i] * m.value()[i]);
+  }
+
+  const mu::quantity<simd_int, mu::second> s{
+      simd_int([](auto i) { return static_cast<std::int32_t>(i); })};
+  const mu::quantity<simd_int, mu::millisecond> ms{s};
+  const auto as_float = mu::quantity_cast<simd_float, mu::millisecond>(ms);
+  for (std::size_t i = 0; i < simd_float::size(); ++i) {
+    ASSERT_EQ(ms.value()[i], 1000 * static_cast<std::int32_t>(i));
+    ASSERT_EQ(as_float.value()[i], 1000.0f * i);
+  }
+}
@@ -0,0 +1,92 @@
+#include "mu_test.hpp"
+#include <mu/units/si_units.hpp>
+#include <type_traits>
+
+using mu::detail::simplify_units_t;
+
+namespace /* local to this file only */ {
+template <mu::units Units> std::string simplified(bool symbols = false) {
+  mu::format_options opts;
+  opts.simplified = true;
+  if (symbols) {
+    opts.labels = mu::format_options::label_type::symbols;
+  }
+  return mu::to_string<Units>(opts);
+}
+} // namespace
+
+CONSTEXPR_TEST(MuSimplify, AlreadySimple) {
+  using u = mu::mult<apples, mu::per<oranges>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, u>);
+}
+
+CONSTEXPR_TEST(MuSimplify, CombineSameUnits) {
+  using u = mu::mult<apples, oranges, apples>;
+  using expected = mu::mult<mu::pow<apples, 2>, oranges>;
+  static_assert(std::is_same_v<simplify_units_t<u>, expected>);
+}
+
+CONSTEXPR_TEST(MuSimplify, DropCancelledUnits) {
+  using u = mu::mult<mu::meter, mu::per<mu::meter>, mu::second>;
+  static_assert(std::is_same_v<simplify_units_t<u>, mu::mult<mu::second>>);
+}
+
+CONSTEXPR_TEST(MuSimplify, PositiveExponentsFirst) {
+  using u = mu::mult<mu::per<mu::second>, mu::meter, mu::per<apples>, oranges>;
+  using expected =
+      mu::mult<mu::meter, oranges, mu::per<mu::second>, mu::per<apples>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, expected>);
+}
+
+CONSTEXPR_TEST(MuSimplify, DistributePow) {
+  using u = mu::mult<mu::pow<mu::mult<apples, oranges>, 2>, mu::per<apples>>;
+  using expected = mu::mult<apples, mu::pow<oranges, 2>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, expected>);
+}
+
+CONSTEXPR_TEST(MuSimplify, FractionalExponents) {
+  using u = mu::mult<mu::root<apples>, mu::root<apples, 3>>;
+  using expected = mu::mult<mu::pow<apples, 5, 6>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, expected>);
+}
+
+CONSTEXPR_TEST(MuSimplify, PrefixStaysAttached) {
+  using u = mu::mult<mu::kilometer, mu::meter, mu::per<mu::kilometer>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, mu::mult<mu::meter>>);
+}
+
+CONSTEXPR_TEST(MuSimplify, NpowCombinesByBase) {
+  using u = mu::mult<mu::pow10<3>, mu::pow10<-5>>;
+  using expected = mu::mult<mu::pow<std::ratio<10>, -2>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, expected>);
+}
+
+CONSTEXPR_TEST(MuSimplify, EverythingCancels) {
+  using u = mu::mult<apples, mu::per<apples>>;
+  static_assert(std::is_same_v<simplify_units_t<u>, mu::mult<>>);
+}
+
+TEST(MuSimplify, ToString) {
+  using u = mu::mult<mu::meter, mu::per<mu::meter>, mu::second, mu::meter>;
+  ASSERT_EQ(mu::to_string<u>({}), "meter * meter^-1 * second * meter");
+  ASSERT_EQ(simplified<u>(), "meter * second");
+}
+
+TEST(MuSimplify, ToStringPrefixes) {
+  using u = mu::mult<mu::kilometer, mu::kilometer, mu::per<mu::hour>>;
+  ASSERT_EQ(simplified<u>(true), "km^2 * hr^-1");
+}
+
+TEST(MuSimplify, ToStringNamedUnitsAreKept) {
+  using u = mu::mult<mu::newton, mu::meter, mu::per<mu::second>>;
+  ASSERT_EQ(simplified<u>(), "newton * meter * second^-1");
+}
+
+TEST(MuSimplify, LabelTable) {
+  using u = mu::mult<apples, apples, mu::per<oranges>>;
+  mu::format_options opts;
+  opts.simplified = true;
+  opts.superscript_exponents = true;
+  ASSERT_EQ(mu::detail::unit_label_table<u>::get(opts).default_value,
+            "apples² * oranges⁻¹");
+}
@@ -0,0 +1,47 @@
+#include "mu_test.hpp"
+#include <mu/detail/static_vector.hpp>
+#include <stdexcept>
+
+using mu::detail::static_vector;
+
+CONSTEXPR_TEST(MuStaticVector, Empty) {
+  constexpr static_vector<int, 4> v;
+  static_assert(v.empty());
+  static_assert(v.size() == 0);
+  static_assert(v.capacity() == 4);
+  static_assert(v.begin() == v.end());
+}
+
+CONSTEXPR_TEST(MuStaticVector, PushAndResize) {
+  constexpr auto v = [] {
+    static_vector<int, 4> v;
+    v.push_back(1);
+    v.emplace_back(2);
+    v.push_back(3);
+    v.resize(2);
+    return v;
+  }();
+  static_assert(v.size() == 2);
+  static_assert(v[0] == 1);
+  static_assert(v[1] == 2);
+}
+
+CONSTEXPR_TEST(MuStaticVector, Equality) {
+  constexpr auto make = [](int last) {
+    static_vector<int, 3> v;
+    v.push_back(1);
+    v.push_back(last);
+    return v;
+  };
+  static_assert(make(2) == make(2));
+  static_assert(!(make(2) == make(3)));
+  static_assert(!(make(2) == static_vector<int, 3>{}));
+}
+
+TEST(MuStaticVector, CapacityExceeded) {
+  static_vector<int, 1> v;
+  v.push_back(1);
+  ASSERT_THROW(v.push_back(2), std::length_error);
+  ASSERT_THROW(v.resize(2), std::length_error);
+  ASSERT_EQ(v.size(), 1);
+}
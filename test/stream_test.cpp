@@ -1,11 +1,26 @@
 #include "mu_test.hpp"
+#include <iomanip>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 struct MuStreamTest : public testing::Test {
   mu::format_options opts;
   std::ostringstream stream;
 };
 
+namespace /* local to this file only */ {
+/// Multiplies 2 apples by one orange for each index, one `operator*` at a
+/// time, so that the units of the product nest once per index.
+template <std::size_t... Indices>
+auto deep_product(std::index_sequence<Indices...>) {
+  mu::quantity<int, apples> q{2};
+  mu::quantity<int, oranges> orange{1};
+  return (q * ... * (static_cast<void>(Indices), orange));
+}
+} // namespace
+
 TEST_F(MuStreamTest, Default) {
   auto q = 3 * apples{} * mu::pow<oranges, -2>{};
   stream << q;
@@ -56,4 +71,136 @@ TEST_F(MuStreamTest, SuperscriptExponents) {
   stream << mu::stream::superscript_exponents << q << " | "
          << mu::stream::ascii_exponents << q;
   ASSERT_EQ(stream.str(), "5 apples² | 5 apples^2");
-}
\ No newline at end of file
+}
+
+TEST_F(MuStreamTest, MultSepIsCopied) {
+  auto q = 3 * apples{} * oranges{};
+  {
+    std::string sep = " + ";
+    stream << mu::stream::mult_sep(sep.c_str());
+  }
+  stream << q;
+  ASSERT_EQ(stream.str(), "3 apples + oranges");
+}
+
+TEST_F(MuStreamTest, CachedLabelFollowsOptions) {
+  auto q = 3 * apples{} * oranges{};
+  stream << mu::stream::mult_sep(" x ") << q << " | " << q << " | "
+         << mu::stream::symbols << q << " | " << mu::stream::mult_sep(" + ")
+         << q;
+  ASSERT_EQ(stream.str(), "3 apples x oranges | 3 apples x oranges | "
+                          "3 🍎 x 🍊 | 3 🍎 + 🍊");
+}
+
+TEST_F(MuStreamTest, CopyFmt) {
+  auto q = 3 * apples{} * oranges{};
+  std::ostringstream other;
+  {
+    std::ostringstream source;
+    source << mu::stream::symbols << mu::stream::mult_sep(" x ") << q;
+    other.copyfmt(source);
+  }
+  other << q;
+  stream.copyfmt(other);
+  stream << q;
+  other << mu::stream::reset;
+  stream << " | " << q;
+  ASSERT_EQ(other.str(), "3 🍎 x 🍊");
+  ASSERT_EQ(stream.str(), "3 🍎 x 🍊 | 3 🍎 x 🍊");
+}
+
+TEST_F(MuStreamTest, CopyFmtWithoutState) {
+  auto q = 3 * apples{} * oranges{};
+  stream << mu::stream::symbols;
+  std::ostringstream source;
+  stream.copyfmt(source);
+  stream << q;
+  ASSERT_EQ(stream.str(), "3 apples * oranges");
+}
+
+TEST_F(MuStreamTest, WriteRange) {
+  std::vector<mu::quantity<double, mu::mult<apples, mu::per<oranges>>>> v{
+      mu::quantity<double, mu::mult<apples, mu::per<oranges>>>{1.5},
+      mu::quantity<double, mu::mult<apples, mu::per<oranges>>>{2},
+      mu::quantity<double, mu::mult<apples, mu::per<oranges>>>{1.0 / 3}};
+  mu::stream::write_range(stream, v);
+  ASSERT_EQ(stream.str(), "1.5, 2, 0.333333 apples * oranges^-1");
+}
+
+TEST_F(MuStreamTest, WriteRangeOptions) {
+  std::vector<mu::quantity<int, mu::mult<apples, oranges>>> v{
+      mu::quantity<int, mu::mult<apples, oranges>>{-1},
+      mu::quantity<int, mu::mult<apples, oranges>>{20}};
+  stream << mu::stream::symbols << mu::stream::mult_sep(" x ");
+  mu::stream::write_range(stream, v, " ");
+  ASSERT_EQ(stream.str(), "-1 20 🍎 x 🍊");
+}
+
+TEST_F(MuStreamTest, WriteRangeEmpty) {
+  std::vector<mu::quantity<int, apples>> v;
+  mu::stream::write_range(stream, v);
+  ASSERT_EQ(stream.str(), " apples");
+}
+
+TEST_F(MuStreamTest, WriteRangeMatchesInsertion) {
+  std::vector<mu::quantity<double, apples>> v;
+  for (int i = 0; i < 500; ++i) {
+    v.emplace_back(1.0e-5 * i * i * i - 3.25 * i);
+  }
+  auto check = [&](auto &&manip) {
+    std::ostringstream expected;
+    std::ostringstream actual;
+    expected << manip;
+    actual << manip;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      expected << (i ? ";" : "") << v[i].value();
+    }
+    expected << " apples";
+    mu::stream::write_range(actual, v, ";");
+    ASSERT_EQ(actual.str(), expected.str());
+  };
+  check(std::defaultfloat);
+  check(std::setprecision(17));
+  check(std::fixed);
+  check(std::scientific);
+  check(std::hexfloat);
+  check(std::showpos);
+  check(std::uppercase);
+}
+
+TEST_F(MuStreamTest, WriteRangeHexIntegers) {
+  std::vector<mu::quantity<int, apples>> v{mu::quantity<int, apples>{255},
+                                           mu::quantity<int, apples>{16}};
+  stream << std::hex;
+  mu::stream::write_range(stream, v);
+  ASSERT_EQ(stream.str(), "ff, 10 apples");
+}
+
+TEST_F(MuStreamTest, WriteColumn) {
+  using fruit = mu::mult<mu::pow<apples, 2>, oranges>;
+  std::vector<mu::quantity<double, fruit>> v{mu::quantity<double, fruit>{1.5},
+                                             mu::quantity<double, fruit>{-2}};
+  stream << mu::stream::superscript_exponents;
+  mu::stream::write_column(stream, "fruit", v);
+  ASSERT_EQ(stream.str(), "fruit [apples² * oranges]\n1.5\n-2\n");
+}
+
+TEST_F(MuStreamTest, Simplified) {
+  auto q = 3 * apples{} * oranges{} * apples{};
+  stream << mu::stream::simplified << q << " | " << mu::stream::as_written
+         << q;
+  ASSERT_EQ(stream.str(),
+            "3 apples^2 * oranges | 3 apples * oranges * apples");
+}
+
+TEST_F(MuStreamTest, DeeplyNestedUnits) {
+  auto q = deep_product(std::make_index_sequence<40>{});
+  using units = decltype(q)::units_type;
+  static_assert(mu::detail::unit_string_depth_v<units> == 40);
+  std::string expected = "2 apples";
+  for (int i = 0; i < 40; ++i) {
+    expected += " * oranges";
+  }
+  stream << q << " | " << mu::stream::simplified << q;
+  ASSERT_EQ(stream.str(), expected + " | 2 apples * oranges^40");
+}
@@ -0,0 +1,67 @@
+#include "mu_test.hpp"
+#include <string>
+
+using mu::detail::unit_label_table;
+using mu::detail::write_unit_label;
+
+namespace /* local to this file only */ {
+template <mu::units Units>
+std::string write_label(const mu::format_options &opts) {
+  std::string out;
+  write_unit_label(unit_label_table<Units>::get(opts), opts.mult_sep,
+                   [&](const char *data, std::size_t size) {
+                     out.append(data, size);
+                   });
+  return out;
+}
+} // namespace
+
+CONSTEXPR_TEST(MuUnitLabel, RenderedAtCompileTime) {
+  using u = mu::mult<apples, mu::pow<oranges, -2>>;
+  constexpr auto &labels = unit_label_table<u>::labels;
+  static_assert(labels[0].default_value == "apples * oranges^-2");
+  static_assert(labels[0].value == "apples\x1foranges^-2");
+  static_assert(labels[0].has_mult_sep);
+  static_assert(labels[1].default_value == "🍎 * 🍊^-2");
+  static_assert(labels[2].default_value == "apples * oranges⁻²");
+  static_assert(labels[3].default_value == "🍎 * 🍊⁻²");
+}
+
+CONSTEXPR_TEST(MuUnitLabel, NoMultSep) {
+  constexpr auto &label = unit_label_table<apples>::labels[0];
+  static_assert(label.value == "apples");
+  static_assert(!label.has_mult_sep);
+}
+
+TEST(MuUnitLabel, WriteDefaultSep) {
+  using u = mu::mult<apples, basket, oranges>;
+  mu::format_options opts;
+  ASSERT_EQ(write_label<u>(opts), mu::to_string<u>(opts));
+}
+
+TEST(MuUnitLabel, WriteCustomSep) {
+  using u = mu::pow<mu::mult<apples, basket, oranges>, 2>;
+  mu::format_options opts;
+  opts.labels = mu::format_options::label_type::symbols;
+  opts.mult_sep = " • ";
+  ASSERT_EQ(write_label<u>(opts), "(🍎 • 🧺🍊)^2");
+  ASSERT_EQ(write_label<u>(opts), mu::to_string<u>(opts));
+}
+
+TEST(MuUnitLabel, WriteEmptySep) {
+  using u = mu::mult<apples, oranges>;
+  mu::format_options opts;
+  opts.mult_sep = "";
+  ASSERT_EQ(write_label<u>(opts), "applesoranges");
+}
+
+CONSTEXPR_TEST(MuUnitLabel, Match) {
+  using mu::detail::match_unit_label;
+  constexpr auto &label =
+      unit_label_table<mu::mult<apples, oranges>>::labels[0];
+  static_assert(match_unit_label(label, " * ", "apples * oranges!") == 16);
+  static_assert(match_unit_label(label, "-", "apples-oranges") == 14);
+  static_assert(match_unit_label(label, " * ", "apples-oranges") == 0);
+  static_assert(match_unit_label(label, " * ", "apples * orange") == 0);
+  static_assert(match_unit_label(label, " * ", "") == 0);
+}
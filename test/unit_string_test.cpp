@@ -13,7 +13,7 @@ constexpr mu::format_options fopts{label_type, " * "};
 } // namespace
 
 struct MuUnitString : public testing::Test {
-  mu::detail::unit_string ustr{fopts};
+  mu::detail::static_unit_string<64, 3> ustr{fopts};
 };
 
 TEST_F(MuUnitString, Empty) { ASSERT_EQ(ustr.str(), ""); }
@@ -87,23 +87,23 @@ TEST_F(MuUnitString, PrefixedSymbolPower) {
 }
 
 CONSTEXPR_TEST(MuUnitString, ConstexprUsage) {
-  constexpr std::string make_str() {
-    mu::detail::unit_string ustr(fopts);
+  constexpr bool check_str() {
+    mu::detail::static_unit_string<7, 1> ustr(fopts);
     ustr.multiply(a);
     ustr.push();
     ustr.multiply(b);
     ustr.pow(2);
     ustr.pop();
-    return ustr.str();
+    return ustr.str() == "a * b^2";
   }
-  static_assert(make_str() == "a * b^2");
+  static_assert(check_str());
 }
 
 TEST_F(MuUnitString, SuperscriptExponent) {
   mu::format_options opts;
   opts.labels = mu::format_options::label_type::symbols;
   opts.superscript_exponents = true;
-  mu::detail::unit_string ustr2{opts};
+  mu::detail::static_unit_string<64, 0> ustr2{opts};
   ustr2.multiply(a);
   mu::detail::ratio exponent{-12345, 67890};
   ustr2.pow(exponent);
@@ -114,4 +114,64 @@ TEST_F(MuUnitString, Npow) {
   using u = mu::npow<7, 99>;
   mu::detail::unit_traits<u>::format(ustr);
   ASSERT_EQ(ustr.str(), "7^99");
-}
\ No newline at end of file
+}
+
+TEST_F(MuUnitString, Measure) {
+  mu::detail::unit_string_stack<0> stack{};
+  mu::detail::unit_string measure{fopts, stack};
+  measure.multiply(a);
+  measure.multiply(b);
+  measure.pow(3);
+  ASSERT_EQ(measure.size(), 9);
+  ASSERT_EQ(measure.str(), "");
+}
+
+TEST_F(MuUnitString, Truncated) {
+  mu::detail::static_unit_string<4, 0> small{fopts};
+  small.multiply(a);
+  small.multiply(b);
+  small.pow(3);
+  ASSERT_EQ(small.size(), 9);
+  ASSERT_EQ(small.str(), "(a *");
+}
+
+TEST_F(MuUnitString, NestedPowParens) {
+  ustr.multiply(a);
+  ustr.push();
+  ustr.multiply(b);
+  ustr.multiply(c);
+  ustr.pow(2);
+  ustr.pop();
+  ustr.pow(-1);
+  ASSERT_EQ(ustr.str(), "(a * (b * c)^2)^-1");
+}
+
+CONSTEXPR_TEST(MuUnitString, StaticLabel) {
+  using u = mu::mult<apples, mu::pow<oranges, -2>>;
+  constexpr std::size_t size = mu::detail::unit_string_size<u>(fopts);
+  static_assert(size == 14);
+  constexpr bool check_label() {
+    constexpr std::size_t depth = mu::detail::unit_string_depth_v<u>;
+    mu::detail::static_unit_string<size, depth> ustr{fopts};
+    mu::detail::unit_traits<u>::format(ustr);
+    return ustr.str() == "🍎 * 🍊^-2";
+  }
+  static_assert(check_label());
+}
+
+CONSTEXPR_TEST(MuUnitString, NestingDepth) {
+  static_assert(mu::detail::nesting_depth_v<apples> == 0);
+  static_assert(mu::detail::nesting_depth_v<mu::mult<>> == 0);
+  static_assert(mu::detail::nesting_depth_v<mu::npow<2, 3>> == 1);
+  static_assert(mu::detail::nesting_depth_v<mu::mult<apples, oranges>> == 1);
+  static_assert(mu::detail::nesting_depth_v<mu::pow<apples, 2>> == 1);
+  using nested = mu::mult<apples, mu::pow<mu::mult<oranges, apples>, 2>>;
+  static_assert(mu::detail::nesting_depth_v<nested> == 3);
+  static_assert(mu::detail::unit_string_depth_v<nested> == 3);
+}
+
+TEST_F(MuUnitString, StackTooSmall) {
+  mu::detail::static_unit_string<64, 1> shallow{fopts};
+  shallow.push();
+  ASSERT_THROW(shallow.push(), std::length_error);
+}
@@ -137,4 +137,26 @@ CONSTEXPR_TEST(MuConversion, ConvertNpows) {
 
   static_assert(units_conversion_v<very_big, big> == 32);
   static_assert(units_conversion_v<big, very_big> == 0.03125l); // 1/32
-}
\ No newline at end of file
+}
+
+CONSTEXPR_TEST(MuConversion, RootsOfPerfectPowers) {
+  using sq_km = mu::pow<mu::kilometer, 2>;
+  using sq_apples = mu::pow<apples, 2>;
+  using root_100_sq_apples = mu::root<mu::mult<std::ratio<100>, sq_apples>>;
+  using root_4_9ths_sq_apples =
+      mu::root<mu::mult<std::ratio<4, 9>, sq_apples>>;
+  using cbrt_n8_cubic_apples =
+      mu::root<mu::mult<std::ratio<-8>, mu::pow<apples, 3>>, 3>;
+
+  // The prime factors of each scale combine to whole exponents, so these
+  // conversions multiply by exact integers.
+  static_assert(std::is_same_v<units_conversion_t<mu::root<sq_km>, mu::meter>,
+                               std::int16_t>);
+  static_assert(units_conversion_v<mu::root<sq_km>, mu::meter> == 1000);
+  static_assert(units_conversion_v<root_100_sq_apples, apples> == 10);
+  static_assert(units_conversion_v<cbrt_n8_cubic_apples, apples> == -2);
+
+  // A perfect power with a negative prime exponent is still a float scale, but
+  // an exact one.
+  static_assert(units_conversion_v<apples, root_4_9ths_sq_apples> == 1.5l);
+}